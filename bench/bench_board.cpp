@@ -0,0 +1,220 @@
+#include "../models/board.h"
+#include "boardgenerator.h"
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer> // Таймер с наносекундной точностью
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <functional>
+
+// Набор бенчмарков доски на синтетических досках разного размера.
+// Запуск: ./scrum_board_bench --sizes 1000,100000,1000000 --seed 42 --json results.json
+// Результаты в JSON (по одному объекту на замер) удобно сравнивать между сборками.
+
+static QTextStream out(stdout);
+
+struct BenchResult {
+    QString name;
+    int tasks;
+    int iterations;
+    qint64 nanoseconds;
+
+    double nsPerOp() const { return double(nanoseconds) / qMax(iterations, 1); }
+};
+
+class BenchRunner {
+public:
+    explicit BenchRunner(const QString& filter) : filter(filter) {}
+
+    // Выполнить body iterations раз (body получает номер итерации) и записать среднее время
+    void run(const QString& name, int tasks, int iterations, const std::function<void(int)>& body) {
+        if (!filter.isEmpty() && !name.contains(filter)) {
+            return;
+        }
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < iterations; i++) {
+            body(i);
+        }
+        BenchResult result{name, tasks, iterations, timer.nsecsElapsed()};
+        results.append(result);
+        out << QString("%1 %2 задач: %3 нс/операция (%4 итераций)")
+                   .arg(name, -32).arg(tasks, 8).arg(result.nsPerOp(), 14, 'f', 1).arg(iterations)
+            << Qt::endl;
+    }
+
+    const QList<BenchResult>& getResults() const { return results; }
+
+private:
+    QString filter;
+    QList<BenchResult> results;
+};
+
+// Старый путь: линейный поиск по списку задач
+static Task* linearFind(TaskRange<Task> tasks, int taskId) {
+    for (Task& task : tasks) {
+        if (task.getId() == taskId) {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+static void benchBoard(BenchRunner& runner, const GeneratorOptions& options, const QString& dir) {
+    const int taskCount = options.tasks;
+    Board board;
+    runner.run("generate", taskCount, 1, [&](int) { generateBoard(board, options); });
+    if (board.getTasks().isEmpty()) {
+        generateBoard(board, options); // Замер генерации отфильтрован, но доска нужна остальным
+    }
+
+    // Один и тот же набор случайных ID для всех замеров поиска по ID
+    QRandomGenerator rng(options.seed);
+    QList<int> ids;
+    for (const Task& task : board.getTasks()) {
+        ids.append(task.getId());
+    }
+    const int lookups = 10000;
+    QList<int> queries;
+    for (int i = 0; i < lookups; i++) {
+        queries.append(ids[rng.bounded(ids.size())]);
+    }
+    quint64 checksum = 0; // Не даём компилятору выбросить вычисления
+
+    runner.run("getTask", taskCount, lookups, [&](int i) {
+        checksum += board.getTask(queries[i])->getId();
+    });
+    // Линейный проход на больших досках сокращаем, чтобы замер шёл разумное время
+    const int linearLookups = qBound(10, int(50000000LL / taskCount), lookups);
+    runner.run("getTask (линейный поиск)", taskCount, linearLookups, [&](int i) {
+        checksum += linearFind(board.getTasks(), queries[i])->getId();
+    });
+
+    runner.run("getTasksByStatus", taskCount, 50, [&](int i) {
+        checksum += board.getTasksByStatus(TaskStatus(i % 5)).size();
+    });
+    runner.run("countTasksByStatus", taskCount, lookups, [&](int i) {
+        checksum += board.countTasksByStatus(TaskStatus(i % 5));
+    });
+    const QList<Developer>& developers = board.getDevelopers();
+    runner.run("getTasksByDeveloper", taskCount, 200, [&](int i) {
+        checksum += board.getTasksByDeveloper(developers[i % developers.size()].getId()).size();
+    });
+    runner.run("getStats", taskCount, lookups, [&](int) {
+        checksum += board.getStats().overdue;
+    });
+
+    // Поиск: запросы - слова и части слов из словаря генератора
+    QStringList searchQueries;
+    for (const QString& word : generatorVocabulary()) {
+        searchQueries << word << word.left(4).toUpper();
+    }
+    runner.run("searchTasks", taskCount, searchQueries.size(), [&](int i) {
+        checksum += board.searchTasks(searchQueries[i]).size();
+    });
+    runner.run("taskMatchesSearch", taskCount, lookups, [&](int i) {
+        checksum += board.taskMatchesSearch(queries[i], searchQueries[i % searchQueries.size()]);
+    });
+
+    runner.run("addHistoryEntry", taskCount, lookups, [&](int i) {
+        board.getTask(queries[i])->addHistoryEntry("Комментарий", "Замер добавления в историю");
+    });
+
+    const QString jsonPath = dir + "/board.json";
+    const QString binaryPath = dir + "/board.sbb";
+    runner.run("saveToFile (JSON)", taskCount, 1, [&](int) { board.saveToFile(jsonPath); });
+    runner.run("saveToFile (sbb)", taskCount, 1, [&](int) { board.saveToFile(binaryPath); });
+    {
+        Board loaded;
+        runner.run("loadFromFile (JSON)", taskCount, 1, [&](int) { loaded.loadFromFile(jsonPath); });
+        runner.run("loadFromFile (sbb)", taskCount, 1, [&](int) { loaded.loadFromFile(binaryPath); });
+    }
+
+    // Удаление половины задач в случайном порядке
+    QList<int> toRemove = ids.mid(0, taskCount / 2);
+    for (int i = toRemove.size() - 1; i > 0; i--) {
+        toRemove.swapItemsAt(i, rng.bounded(i + 1));
+    }
+    runner.run("removeTask", taskCount, toRemove.size(), [&](int i) {
+        board.removeTask(toRemove[i]);
+    });
+
+    out << "checksum: " << checksum << Qt::endl;
+}
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Бенчмарки скрам-доски на синтетических досках");
+    parser.addHelpOption();
+    QCommandLineOption sizesOption("sizes", "Размеры досок через запятую (по умолчанию 1000,10000,100000).", "n,n,...",
+                                   "1000,10000,100000");
+    QCommandLineOption seedOption("seed", "Seed генератора досок.", "seed", "42");
+    QCommandLineOption historyOption("history", "Средняя глубина истории задачи.", "n", "8");
+    QCommandLineOption developersOption("developers", "Число разработчиков.", "n", "20");
+    QCommandLineOption jsonOption("json", "Записать результаты в JSON-файл.", "файл");
+    QCommandLineOption filterOption("filter", "Запускать только замеры, имя которых содержит строку.", "строка");
+    parser.addOptions({sizesOption, seedOption, historyOption, developersOption, jsonOption, filterOption});
+    parser.addPositionalArgument("размер", "Размер доски (как --sizes с одним значением).", "[размер]");
+    parser.process(app);
+
+    QStringList sizes = parser.value(sizesOption).split(',', Qt::SkipEmptyParts);
+    if (!parser.positionalArguments().isEmpty()) {
+        sizes = parser.positionalArguments().mid(0, 1); // Старый вызов: ./scrum_board_bench 20000
+    }
+
+    GeneratorOptions options;
+    options.seed = parser.value(seedOption).toUInt();
+    options.historyDepth = parser.value(historyOption).toInt();
+    options.developers = qMax(1, parser.value(developersOption).toInt());
+
+    QTemporaryDir dir; // Файлы для замеров сохранения и загрузки
+    if (!dir.isValid()) {
+        QTextStream(stderr) << "Не удалось создать временный каталог" << Qt::endl;
+        return 1;
+    }
+
+    BenchRunner runner(parser.value(filterOption));
+    for (const QString& size : sizes) {
+        options.tasks = size.trimmed().toInt();
+        if (options.tasks <= 0) {
+            continue;
+        }
+        out << "== Доска: " << options.tasks << " задач, история ~" << options.historyDepth
+            << ", seed " << options.seed << " ==" << Qt::endl;
+        benchBoard(runner, options, dir.path());
+    }
+
+    if (parser.isSet(jsonOption)) {
+        QJsonArray results;
+        for (const BenchResult& result : runner.getResults()) {
+            QJsonObject item;
+            item["name"] = result.name;
+            item["tasks"] = result.tasks;
+            item["iterations"] = result.iterations;
+            item["totalNs"] = double(result.nanoseconds);
+            item["nsPerOp"] = result.nsPerOp();
+            results.append(item);
+        }
+        QJsonObject root;
+        root["seed"] = double(options.seed);
+        root["historyDepth"] = options.historyDepth;
+        root["developers"] = options.developers;
+        root["qtVersion"] = QString(qVersion());
+        root["results"] = results;
+
+        QFile file(parser.value(jsonOption));
+        if (!file.open(QIODevice::WriteOnly) || file.write(QJsonDocument(root).toJson()) < 0) {
+            QTextStream(stderr) << "Не удалось записать " << parser.value(jsonOption) << Qt::endl;
+            return 1;
+        }
+    }
+    return 0;
+}
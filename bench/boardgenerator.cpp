@@ -0,0 +1,96 @@
+#include "boardgenerator.h"
+#include <QRandomGenerator>
+
+static const char* const verbs[] = {
+    "Исправить", "Добавить", "Переписать", "Проверить", "Обновить", "Удалить", "Ускорить", "Описать"
+};
+static const char* const objects[] = {
+    "форму входа", "экспорт отчёта", "загрузку файлов", "страницу профиля", "поиск задач",
+    "уведомления", "кэш запросов", "миграцию базы", "модуль оплаты", "журнал событий",
+    "настройки доступа", "импорт пользователей", "сборку проекта", "документацию API"
+};
+static const char* const details[] = {
+    "после обновления", "на мобильных устройствах", "для больших файлов", "в ночной сборке",
+    "по просьбе клиента", "из-за таймаута", "при медленной сети", "в старых браузерах"
+};
+static const char* const comments[] = {
+    "Обсудили на планировании", "Нужна помощь тестировщика", "Ждём ответа заказчика",
+    "Блокер снят", "Добавлены логи", "Воспроизводится не всегда"
+};
+
+template <typename T, int N>
+static const char* pick(QRandomGenerator& rng, T (&words)[N]) {
+    return words[rng.bounded(N)];
+}
+
+QStringList generatorVocabulary() {
+    QStringList words;
+    for (const char* verb : verbs) words << QString::fromUtf8(verb);
+    for (const char* object : objects) words << QString::fromUtf8(object);
+    for (const char* detail : details) words << QString::fromUtf8(detail);
+    return words;
+}
+
+// Следующий статус по обычному ходу работы
+static TaskStatus nextStatus(TaskStatus status) {
+    switch (status) {
+    case TaskStatus::Backlog:    return TaskStatus::Assigned;
+    case TaskStatus::Assigned:   return TaskStatus::InProgress;
+    case TaskStatus::InProgress: return TaskStatus::Review;
+    case TaskStatus::Review:     return TaskStatus::Done;
+    case TaskStatus::Done:       return TaskStatus::Done;
+    }
+    return TaskStatus::Backlog;
+}
+
+void generateBoard(Board& board, const GeneratorOptions& options) {
+    board.clear();
+    QRandomGenerator rng(options.seed);
+
+    QList<int> developerIds;
+    for (int i = 0; i < options.developers; i++) {
+        developerIds.append(board.createDeveloper(QString("Разработчик %1").arg(i + 1), "Программист")->getId());
+    }
+
+    // Задачи добавляются пакетами: индексы и поиск строятся одним проходом на пакет,
+    // а копии задач в операциях не удваивают память на больших досках
+    const int batchSize = 10000;
+    const QDateTime now = QDateTime::currentDateTime();
+    QVector<BoardOperation> operations;
+    operations.reserve(qMin(options.tasks, batchSize));
+    for (int i = 0; i < options.tasks; i++) {
+        // Случайные числа берём по одному: порядок вычисления аргументов не определён,
+        // а доска для одного seed должна быть одинаковой при любом компиляторе
+        const QString verb = pick(rng, verbs);
+        const QString object = pick(rng, objects);
+        const QString about = pick(rng, objects);
+        const QString detail = pick(rng, details);
+        Task task(board.allocateTaskId(), verb + " " + object, about + " " + detail);
+
+        // Глубина истории - от 0 до удвоенного среднего
+        const int depth = options.historyDepth > 0 ? int(rng.bounded(options.historyDepth * 2 + 1)) : 0;
+        for (int step = 0; step < depth; step++) {
+            const int kind = rng.bounded(10);
+            if (kind < 4) {
+                // Задача двигается вперёд; иногда возвращается на доработку
+                task.setStatus(task.getStatus() == TaskStatus::Review && rng.bounded(3) == 0
+                                   ? TaskStatus::InProgress : nextStatus(task.getStatus()));
+            } else if (kind < 6 && !developerIds.isEmpty()) {
+                task.assignToDeveloper(developerIds[rng.bounded(developerIds.size())]);
+            } else if (kind < 7) {
+                task.setDescription(task.getDescription() + " " + pick(rng, details));
+            } else if (kind < 8) {
+                task.setDeadline(now.addDays(int(rng.bounded(60)) - 20)); // Есть и просроченные
+            } else {
+                task.addHistoryEntry("Комментарий", QString::fromUtf8(pick(rng, comments)));
+            }
+        }
+        operations.append(BoardOperation::addTask(task));
+        if (operations.size() == batchSize) {
+            board.applyBatch(operations);
+            operations.clear();
+        }
+    }
+    board.applyBatch(operations);
+    board.takeChanges();
+}
@@ -0,0 +1,24 @@
+#ifndef BOARDGENERATOR_H
+#define BOARDGENERATOR_H
+
+#include <QStringList>
+#include "../models/board.h"
+
+// Параметры синтетической доски для бенчмарков
+struct GeneratorOptions {
+    int tasks = 1000;
+    int developers = 20;
+    int historyDepth = 8; // Среднее число изменений задачи после создания
+    quint32 seed = 42;    // Одинаковый seed - одинаковая доска
+};
+
+// Заполнить доску задачами, похожими на настоящие: названия и описания из словаря,
+// статусы распределены по колонкам неравномерно (больше всего в Backlog и Done),
+// у части задач есть исполнитель и дедлайн, история - смены статуса, назначения,
+// правки названия/описания и комментарии. Доска предварительно очищается
+void generateBoard(Board& board, const GeneratorOptions& options);
+
+// Слова из словаря генератора - для поисковых запросов бенчмарка
+QStringList generatorVocabulary();
+
+#endif // BOARDGENERATOR_H
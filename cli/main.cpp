@@ -0,0 +1,312 @@
+#include "../models/board.h"
+#include "../models/trace.h"
+
+#include <QCoreApplication> // Без виджетов: только QtCore
+#include <QCommandLineParser>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QThreadPool>
+#include <QVector>
+#include <algorithm>
+
+// Консольная обработка досок без интерфейса: загрузка, отбор задач,
+// статистика, массовая смена статуса и сохранение.
+// Пример: scrum_board_cli --status Review --set-status Done --stats boards/*.json
+// Запросы (см. BoardQuery): scrum_board_cli --query "is:overdue -assignee:none" --explain --list board.sbb
+
+namespace {
+
+struct Options {
+    bool filterStatus = false;
+    TaskStatus status = TaskStatus::Backlog;
+    bool filterAssignee = false;
+    int assignee = -1;
+    QString text;
+    bool overdue = false;
+    bool hasQuery = false;
+    BoardQuery query;
+    bool explain = false;
+
+    bool list = false;
+    bool stats = false;
+    bool json = false;
+
+    bool changeStatus = false;
+    TaskStatus newStatus = TaskStatus::Backlog;
+    QString output; // Куда сохранить (только для одного файла); иначе - в исходный файл
+};
+
+// Результат обработки одного файла
+struct FileResult {
+    QString text;
+    QJsonObject json;
+    bool ok = true;
+};
+
+bool parseStatus(const QString& text, TaskStatus& status) {
+    status = Task::stringToStatus(text);
+    return Task::statusToString(status) == text; // stringToStatus не сообщает об ошибке
+}
+
+QJsonObject statsJson(const BoardStats& stats) {
+    QJsonObject json;
+    json["total"] = stats.total;
+    for (int i = 0; i < 5; i++) {
+        json[Task::statusToString(TaskStatus(i))] = stats.byStatus[i];
+    }
+    json["unassignedActive"] = stats.unassignedActive;
+    json["overdue"] = stats.overdue;
+    json["dueToday"] = stats.dueToday;
+    json["dueSoon"] = stats.dueSoon;
+    json["percentDone"] = stats.percentDone();
+    return json;
+}
+
+// Задачи, прошедшие все фильтры, в порядке ID. plan - объяснение плана запроса (для --query)
+QList<Task*> selectTasks(Board& board, const Options& options, QString& plan) {
+    QList<Task*> candidates;
+    if (options.hasQuery) {
+        QueryResult result = board.query(options.query); // Индексы выбирает планировщик запроса
+        plan = result.plan;
+        for (int taskId : result.ids) {
+            candidates.append(board.getTask(taskId));
+        }
+    } else if (options.filterStatus) {
+        candidates = board.getTasksByStatus(options.status); // Индекс статусов вместо обхода
+    } else if (options.filterAssignee) {
+        candidates = board.getTasksByDeveloper(options.assignee);
+    } else {
+        for (Task& task : board.getTasks()) {
+            candidates.append(&task);
+        }
+    }
+
+    const QDateTime now = QDateTime::currentDateTime();
+    QList<Task*> selected;
+    for (Task* task : candidates) {
+        if (options.filterStatus && task->getStatus() != options.status) continue;
+        if (options.filterAssignee && task->getAssignedDeveloperId() != options.assignee) continue;
+        if (options.overdue && !task->isOverdue(now)) continue;
+        if (!options.text.isEmpty() && !board.taskMatchesSearch(task->getId(), options.text)) continue;
+        selected.append(task);
+    }
+    std::sort(selected.begin(), selected.end(), [](const Task* a, const Task* b) {
+        return a->getId() < b->getId();
+    });
+    return selected;
+}
+
+FileResult processFile(const QString& path, const Options& options) {
+    FileResult result;
+    QTextStream out(&result.text);
+    result.json["file"] = path;
+    if (!options.json) {
+        out << "== " << path << " ==" << Qt::endl;
+    }
+
+    auto fail = [&](const QString& error) {
+        result.ok = false;
+        result.json["error"] = error;
+        if (!options.json) {
+            out << "Ошибка: " << error << Qt::endl;
+        }
+        return result;
+    };
+
+    Board board; // Своя доска в каждом потоке
+    if (!board.loadFromFile(path)) {
+        return fail("не удалось загрузить доску");
+    }
+    board.updateDeadlines(); // Статистика и is:overdue - на момент окончания загрузки
+    if (!options.text.isEmpty() || options.hasQuery) {
+        board.indexHistory(); // История из *.sbb нужна поиску по тексту
+    }
+
+    if (options.stats) {
+        const BoardStats& stats = board.getStats();
+        result.json["stats"] = statsJson(stats);
+        if (!options.json) {
+            out << "Задач: " << stats.total << ", выполнено " << stats.percentDone() << "%" << Qt::endl;
+            for (int i = 0; i < 5; i++) {
+                out << "  " << Task::statusToString(TaskStatus(i)) << ": " << stats.byStatus[i] << Qt::endl;
+            }
+            out << "Просрочено: " << stats.overdue << ", сегодня: " << stats.dueToday
+                << ", скоро: " << stats.dueSoon << ", не назначено: " << stats.unassignedActive << Qt::endl;
+        }
+    }
+
+    QString plan;
+    const QList<Task*> selected = selectTasks(board, options, plan);
+    result.json["selected"] = selected.size();
+    if (options.explain) {
+        result.json["plan"] = plan;
+        if (!options.json) {
+            out << plan << Qt::endl;
+        }
+    }
+    if (options.list) {
+        QJsonArray tasks;
+        for (const Task* task : selected) {
+            QJsonObject item;
+            item["id"] = task->getId();
+            item["status"] = Task::statusToString(task->getStatus());
+            item["assignedDeveloperId"] = task->getAssignedDeveloperId();
+            item["title"] = task->getTitle();
+            tasks.append(item);
+            if (!options.json) {
+                out << "#" << task->getId() << " [" << Task::statusToString(task->getStatus()) << "] ";
+                if (task->isAssigned()) {
+                    out << "(разработчик " << task->getAssignedDeveloperId() << ") ";
+                }
+                out << task->getTitle() << Qt::endl;
+            }
+        }
+        result.json["tasks"] = tasks;
+    }
+    if (!options.json) {
+        out << "Отобрано задач: " << selected.size() << Qt::endl;
+    }
+
+    if (options.changeStatus) {
+        // Все изменения одним пакетом: индексы и история обновляются за один проход
+        QVector<BoardOperation> operations;
+        for (const Task* task : selected) {
+            if (task->getStatus() != options.newStatus) {
+                operations.append(BoardOperation::setStatus(task->getId(), options.newStatus));
+            }
+        }
+        QString error;
+        if (!board.applyBatch(operations, &error)) {
+            return fail(error);
+        }
+        result.json["changed"] = operations.size();
+        if (!options.json) {
+            out << "Статус изменён у " << operations.size() << " задач" << Qt::endl;
+        }
+    }
+
+    // Сохраняем, если доска изменилась или задан другой файл (например, смена формата)
+    const QString target = options.output.isEmpty() ? path : options.output;
+    if (!result.json.value("changed").toInt() && target == path) {
+        return result;
+    }
+    if (!board.saveToFile(target)) {
+        return fail("не удалось сохранить " + target);
+    }
+    result.json["saved"] = target;
+    if (!options.json) {
+        out << "Сохранено: " << target << Qt::endl;
+    }
+    return result;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    QCoreApplication app(argc, argv);
+    Trace::startFromEnvironment();
+    QCoreApplication::setApplicationName("scrum_board_cli");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Обработка файлов скрам-доски (*.json, *.sbb) без графического интерфейса");
+    parser.addHelpOption();
+    QCommandLineOption statusOption("status", "Отобрать задачи со статусом.", "статус");
+    QCommandLineOption assigneeOption("assignee", "Отобрать задачи разработчика (-1 - неназначенные).", "id");
+    QCommandLineOption textOption("text", "Отобрать задачи, содержащие текст (название, описание, история).", "текст");
+    QCommandLineOption overdueOption("overdue", "Только просроченные задачи.");
+    QCommandLineOption queryOption("query", "Отобрать задачи запросом, например \"status:Review -assignee:none\".", "запрос");
+    QCommandLineOption explainOption("explain", "Показать план запроса: индексы и число проверенных задач.");
+    QCommandLineOption listOption("list", "Вывести отобранные задачи.");
+    QCommandLineOption statsOption("stats", "Вывести статистику доски.");
+    QCommandLineOption setStatusOption("set-status", "Перевести отобранные задачи в статус и сохранить доску.", "статус");
+    QCommandLineOption outputOption("output", "Сохранить в этот файл (формат - по расширению).", "файл");
+    QCommandLineOption jsonOption("json", "Вывод в формате JSON: одна строка на файл.");
+    QCommandLineOption jobsOption("jobs", "Сколько файлов обрабатывать одновременно.", "n");
+    parser.addOptions({statusOption, assigneeOption, textOption, overdueOption, queryOption, explainOption,
+                       listOption, statsOption, setStatusOption, outputOption, jsonOption, jobsOption});
+    parser.addPositionalArgument("файлы", "Файлы досок.", "файл...");
+    parser.process(app);
+
+    QTextStream err(stderr);
+    const QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        err << "Не указаны файлы досок" << Qt::endl;
+        return 2;
+    }
+
+    Options options;
+    if (parser.isSet(statusOption)) {
+        options.filterStatus = true;
+        if (!parseStatus(parser.value(statusOption), options.status)) {
+            err << "Неизвестный статус: " << parser.value(statusOption) << Qt::endl;
+            return 2;
+        }
+    }
+    if (parser.isSet(assigneeOption)) {
+        bool ok = false;
+        options.filterAssignee = true;
+        options.assignee = parser.value(assigneeOption).toInt(&ok);
+        if (!ok) {
+            err << "ID разработчика должен быть числом" << Qt::endl;
+            return 2;
+        }
+    }
+    options.text = parser.value(textOption);
+    options.overdue = parser.isSet(overdueOption);
+    if (parser.isSet(queryOption)) {
+        QString error;
+        options.hasQuery = true;
+        if (!BoardQuery::parse(parser.value(queryOption), options.query, &error)) {
+            err << "Ошибка в запросе: " << error << Qt::endl;
+            return 2;
+        }
+    }
+    options.explain = parser.isSet(explainOption);
+    if (options.explain && !options.hasQuery) {
+        err << "--explain показывает план для --query" << Qt::endl;
+        return 2;
+    }
+    options.list = parser.isSet(listOption);
+    options.stats = parser.isSet(statsOption);
+    options.json = parser.isSet(jsonOption);
+    if (parser.isSet(setStatusOption)) {
+        options.changeStatus = true;
+        if (!parseStatus(parser.value(setStatusOption), options.newStatus)) {
+            err << "Неизвестный статус: " << parser.value(setStatusOption) << Qt::endl;
+            return 2;
+        }
+    }
+    options.output = parser.value(outputOption);
+    if (!options.output.isEmpty() && files.size() > 1) {
+        err << "--output можно указать только для одного файла" << Qt::endl;
+        return 2;
+    }
+
+    // Файлы независимы - обрабатываем их в пуле потоков, а вывод печатаем по порядку
+    QThreadPool pool;
+    if (parser.isSet(jobsOption)) {
+        pool.setMaxThreadCount(qMax(1, parser.value(jobsOption).toInt()));
+    }
+    QVector<FileResult> results(files.size());
+    for (int i = 0; i < files.size(); i++) {
+        pool.start([&results, &files, &options, i]() {
+            results[i] = processFile(files[i], options);
+        });
+    }
+    pool.waitForDone();
+
+    QTextStream out(stdout);
+    bool allOk = true;
+    for (const FileResult& result : results) {
+        if (options.json) {
+            out << QJsonDocument(result.json).toJson(QJsonDocument::Compact) << Qt::endl;
+        } else {
+            out << result.text;
+        }
+        allOk = allOk && result.ok;
+    }
+    Trace::finish();
+    return allOk ? 0 : 1;
+}
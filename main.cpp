@@ -1,5 +1,6 @@
 #include "mainwindow.h"
 #include "widgets/startscreen.h"
+#include "models/trace.h"
 
 #include <QApplication> // Основной класс приложения Qt
 #include <QStackedWidget> // Виджет для переключения экранов
@@ -7,6 +8,7 @@
 int main(int argc, char *argv[])
 {
     QApplication a(argc, argv); // Создаем объект приложения Qt
+    Trace::startFromEnvironment(); // SCRUM_BOARD_TRACE=trace.json - записать замеры времени
 
     // Создаем контейнер для переключения между экранами
     QStackedWidget* stackedWidget = new QStackedWidget();
@@ -18,9 +20,7 @@ int main(int argc, char *argv[])
 
     // Создаем главное окно (но не показываем пока)
     MainWindow* mainWindow = nullptr;
-
-    // Обработчик "Новая доска"
-    QObject::connect(startScreen, &StartScreen::newBoardRequested, [&]() {
+    auto createMainWindow = [&]() {
         if (!mainWindow) {
             mainWindow = new MainWindow(); // 1. Создаем главное окно
             stackedWidget->addWidget(mainWindow); // 2. Добавляем его в стек
@@ -30,24 +30,30 @@ int main(int argc, char *argv[])
                 stackedWidget->setCurrentWidget(startScreen);   // Возвращаемся на старт
             });
         }
+    };
+
+    // Обработчик "Новая доска"
+    QObject::connect(startScreen, &StartScreen::newBoardRequested, [&]() {
+        createMainWindow();
         stackedWidget->setCurrentWidget(mainWindow); // 3. Показываем главное окно
     });
 
     // Обработчик "Загрузить доску"
     QObject::connect(startScreen, &StartScreen::loadBoardRequested, [&](const QString& filePath) {
-        if (!mainWindow) {
-            mainWindow = new MainWindow();
-            stackedWidget->addWidget(mainWindow);
-
-            // Обработчик возврата на стартовый экран
-            QObject::connect(mainWindow, &MainWindow::backToStartScreen, [&]() {
-                stackedWidget->setCurrentWidget(startScreen);
-            });
-        }
+        createMainWindow();
         mainWindow->loadBoard(filePath); // Загружает сохраненную доску из файла
         stackedWidget->setCurrentWidget(mainWindow);
     });
 
+    // Несохранённые изменения прошлого запуска предлагаются сразу, до выбора доски:
+    // так восстановленная доска не спорит с файлом, который пользователь выберет потом
+    if (MainWindow::hasRecovery()) {
+        createMainWindow();
+        if (mainWindow->offerRecovery()) {
+            stackedWidget->setCurrentWidget(mainWindow);
+        }
+    }
+
     // Обработчик "Выйти"
     QObject::connect(startScreen, &StartScreen::exitRequested, [&]() {
         a.quit(); // Завершаем приложение
@@ -55,5 +61,7 @@ int main(int argc, char *argv[])
 
     stackedWidget->showMaximized(); // Показываем на весь экран
 
-    return a.exec();  // Запускаем главный цикл обработки событий (клики мыши, нажатия клавиши, работает до закрытия окна)
+    int result = a.exec();  // Запускаем главный цикл обработки событий (клики мыши, нажатия клавиши, работает до закрытия окна)
+    Trace::finish(); // Файл трассы открывается в chrome://tracing или ui.perfetto.dev
+    return result;
 }
\ No newline at end of file
@@ -1,6 +1,7 @@
 #include "mainwindow.h"               
 #include "./ui_mainwindow.h"            
 #include "widgets/taskcard.h"           
+#include "models/trace.h"              // Замеры времени (TRACE_SCOPE)
 #include <QHBoxLayout>                 
 #include <QVBoxLayout>                
 #include <QMenuBar>                  
@@ -19,23 +20,107 @@
 #include <QComboBox>                  
 #include <QDateEdit>                   
 #include <QCheckBox>                  
-#include <QDebug>                     
 #include <QTextCursor>              
+#include <QThreadPool>              // Пул потоков для фонового поиска
+#include <QApplication>
+#include <QPointer>
+#include <QProgressDialog>
+#include <QStandardPaths>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStatusBar>
+#include <QTime>
+
+// Порог числа задач для перехода на виртуализированные колонки и обратно
+// (разные значения, чтобы режим не переключался туда-сюда на границе)
+static const int virtualModeEnterThreshold = 1000;
+static const int virtualModeLeaveThreshold = 750;
+
+// Пауза после последнего нажатия клавиши перед запуском поиска, мс
+static const int searchDebounceMs = 200;
+
+// Журнал изменений доски: как часто дожидаться записи на диск (одна синхронизация
+// на все изменения за интервал)
+static const int journalSyncMs = 1000;
+
+// Как часто проверять, не пора ли автосохранить изменившуюся доску, мс
+static const int autosaveIntervalMs = 30000;
+
+// Наибольшая пауза таймера дедлайнов, мс: после сна системы или перевода часов
+// срочность задач обновится не позже чем через это время
+static const int deadlineTimerMaxMs = 60 * 60 * 1000;
+
+// Подсказка к полю поиска: кроме текста оно понимает запросы (см. BoardQuery)
+static const char* searchHelp =
+    "Текст или запрос: status:Review, assignee:3, due:2026-03-01..2026-03-31,\n"
+    "is:overdue, history:status, text:\"слово\"; -условие, OR, скобки";
 
 // Конструктор главного окна приложения
 MainWindow::MainWindow(QWidget *parent)
     : QMainWindow(parent)
     , ui(new Ui::MainWindow) { // Инициализация пользовательского интерфейса
     ui->setupUi(this);
+
+    searchGeneration = std::make_shared<std::atomic<int>>(0);
+    searchTimer = new QTimer(this);
+    searchTimer->setSingleShot(true);
+    searchTimer->setInterval(searchDebounceMs);
+    connect(searchTimer, &QTimer::timeout, this, &MainWindow::startSearch);
+
+    journalTimer = new QTimer(this);
+    journalTimer->setInterval(journalSyncMs);
+    connect(journalTimer, &QTimer::timeout, this, [this]() {
+        board.syncJournal();
+    });
+    journalTimer->start();
+
+    deadlineTimer = new QTimer(this);
+    deadlineTimer->setSingleShot(true);
+    connect(deadlineTimer, &QTimer::timeout, this, &MainWindow::refreshBoard);
+
+    autosavePool.setMaxThreadCount(1); // Записи снимков не должны обгонять друг друга
+    autosaveTimer = new QTimer(this);
+    autosaveTimer->setInterval(autosaveIntervalMs);
+    connect(autosaveTimer, &QTimer::timeout, this, &MainWindow::startAutosave);
+    autosaveTimer->start();
+
     setupUI();
     setupMenuBar();
     setupToolBar();
     setWindowTitle("Скрам Доска");
+
+    // Индикатор автосохранения справа в строке состояния
+    autosaveLabel = new QLabel(this);
+    autosaveProgress = new QProgressBar(this);
+    autosaveProgress->setRange(0, 100);
+    autosaveProgress->setMaximumWidth(120);
+    autosaveProgress->hide();
+    statusBar()->addPermanentWidget(autosaveLabel);
+    statusBar()->addPermanentWidget(autosaveProgress);
+
+    savedRevision = board.getRevision();
     updateStatistics();
+    updateUndoActions();
+    if (!hasRecovery()) {
+        resetRecovery(QString()); // Иначе журнал откроет offerRecovery(): её вызывает main() при запуске
+    }
 }
 
 // Деструктор главного окна
 MainWindow::~MainWindow() {
+    autosaveGeneration++; // Окно закрывается - результат фоновой записи уже не показываем
+    autosavePool.waitForDone();
+    if (board.getRevision() == savedRevision) {
+        // Обычный выход без несохранённых изменений - восстанавливать нечего
+        board.closeJournal();
+        QFile::remove(recoveryFilePath());
+        QFile::remove(BoardJournal::journalFileName(recoveryFilePath()));
+        QFile::remove(recoveryBasePath());
+    } else if (board.getRevision() != recoveryRevision) {
+        // Несохранённые изменения остаются в файле восстановления - их предложат при следующем запуске
+        board.compactJournal();
+    }
     delete ui;
 }
 
@@ -68,12 +153,28 @@ void MainWindow::setupUI() {
         connect(column, &ColumnWidget::taskDropped, this, &MainWindow::onTaskDropped);
     }
     
+    // Виртуализированные колонки с теми же заголовками и цветами (скрыты, пока доска небольшая)
+    virtualColumns[TaskStatus::Backlog] = new VirtualColumnWidget("БЭКЛОГ", "#FFE082", TaskStatus::Backlog, &board, this);
+    virtualColumns[TaskStatus::Assigned] = new VirtualColumnWidget("НАДО", "#90CAF9", TaskStatus::Assigned, &board, this);
+    virtualColumns[TaskStatus::InProgress] = new VirtualColumnWidget("ДЕЛАТЬ", "#80CBC4", TaskStatus::InProgress, &board, this);
+    virtualColumns[TaskStatus::Review] = new VirtualColumnWidget("ПРОВЕРКА", "#CE93D8", TaskStatus::Review, &board, this);
+    virtualColumns[TaskStatus::Done] = new VirtualColumnWidget("СДЕЛАНО!", "#A5D6A7", TaskStatus::Done, &board, this);
+
+    for (VirtualColumnWidget* column : virtualColumns) {
+        column->model()->setFilter([this](const Task& task) { return matchesSearch(&task); });
+        column->hide();
+        connect(column, &VirtualColumnWidget::taskDropped, this, &MainWindow::onTaskDropped);
+        connect(column, &VirtualColumnWidget::editClicked, this, &MainWindow::onTaskEdit);
+        connect(column, &VirtualColumnWidget::deleteClicked, this, &MainWindow::onTaskDelete);
+        connect(column, &VirtualColumnWidget::statusChangeClicked, this, &MainWindow::onTaskStatusChange);
+    }
+
     // Добавление колонок в основной компоновщик в порядке слева направо
-    mainLayout->addWidget(columns[TaskStatus::Backlog]);
-    mainLayout->addWidget(columns[TaskStatus::Assigned]);
-    mainLayout->addWidget(columns[TaskStatus::InProgress]);
-    mainLayout->addWidget(columns[TaskStatus::Review]);
-    mainLayout->addWidget(columns[TaskStatus::Done]);
+    for (TaskStatus status : {TaskStatus::Backlog, TaskStatus::Assigned, TaskStatus::InProgress,
+                              TaskStatus::Review, TaskStatus::Done}) {
+        mainLayout->addWidget(columns[status]);
+        mainLayout->addWidget(virtualColumns[status]);
+    }
 }
 
 void MainWindow::setupMenuBar() {
@@ -106,6 +207,16 @@ void MainWindow::setupMenuBar() {
     exitAction->setShortcut(QKeySequence("Ctrl+Q"));
     connect(exitAction, &QAction::triggered, this, &MainWindow::backToStartScreen);
 
+    QMenu* editMenu = menuBar->addMenu("Правка");
+
+    undoAction = editMenu->addAction("Отменить");
+    undoAction->setShortcut(QKeySequence::Undo);  // Ctrl+Z
+    connect(undoAction, &QAction::triggered, this, &MainWindow::onUndo);
+
+    redoAction = editMenu->addAction("Повторить");
+    redoAction->setShortcut(QKeySequence::Redo);  // Ctrl+Shift+Z / Ctrl+Y
+    connect(redoAction, &QAction::triggered, this, &MainWindow::onRedo);
+
     QMenu* devMenu = menuBar->addMenu("Разработчики");
 
     QAction* addDevAction = devMenu->addAction("Добавить разработчика");
@@ -121,6 +232,9 @@ void MainWindow::setupMenuBar() {
     QAction* addTaskAction = taskMenu->addAction("Добавить задачу");
     addTaskAction->setShortcut(QKeySequence("Ctrl+T"));
     connect(addTaskAction, &QAction::triggered, this, &MainWindow::onAddTask);
+
+    QAction* completeReviewedAction = taskMenu->addAction("Завершить все проверенные задачи");
+    connect(completeReviewedAction, &QAction::triggered, this, &MainWindow::onCompleteReviewed);
 }
 
 void MainWindow::setupToolBar() {
@@ -132,7 +246,8 @@ void MainWindow::setupToolBar() {
     toolBar->addWidget(searchLabel);
 
     searchBox = new QLineEdit(this); // Создание поля ввода для поиска
-    searchBox->setPlaceholderText("Введите название задачи...");
+    searchBox->setPlaceholderText("Название, описание или история...");
+    searchBox->setToolTip(searchHelp);
     searchBox->setMinimumWidth(200);
     connect(searchBox, &QLineEdit::textChanged, this, &MainWindow::onSearchTextChanged);
     toolBar->addWidget(searchBox); // Добавление поля поиска на панель
@@ -146,66 +261,445 @@ void MainWindow::setupToolBar() {
 }
 
 void MainWindow::refreshBoard() {
-    qDebug() << "refreshBoard вызван";
+    TRACE_SCOPE("MainWindow::refreshBoard");
+
+    // Задачи, у которых наступил дедлайн или сменилась срочность, доска
+    // находит по индексу дедлайнов и сообщает вместе с остальными изменениями
+    board.updateDeadlines();
+    // Доска сообщает, какие задачи изменились с прошлого обновления
+    BoardChanges changes = board.takeChanges();
+
+    // Изменённые задачи могли начать или перестать подходить под запрос -
+    // перепроверяем только их
+    if (changes.reset) {
+        if (searchFilter.isEmpty()) {
+            searchMatches.clear();
+        } else {
+            board.indexHistory();
+            searchMatches = searchQuery.isPlainText() ? board.searchTasks(searchFilter) : board.query(searchQuery).ids;
+        }
+    } else {
+        for (int taskId : changes.removed) {
+            searchMatches.remove(taskId);
+        }
+        for (int taskId : changes.changed) {
+            updateSearchMatch(taskId);
+        }
+    }
+    if (searchInFlight) {
+        changedDuringSearch.unite(changes.changed);
+    }
+    if (updateVirtualMode()) {
+        changes.reset = true;
+    }
+
+    if (virtualMode) {
+        // Модели колонок обновляют только затронутые строки
+        for (VirtualColumnWidget* column : virtualColumns) {
+            column->model()->applyChanges(changes);
+        }
+    } else if (changes.reset) {
+        rebuildBoard();
+    } else {
+        for (int taskId : changes.removed) {
+            removeTaskCard(taskId);
+        }
+        for (int taskId : changes.changed) {
+            // Карточку пересоздаём: задача могла сменить колонку
+            removeTaskCard(taskId);
+            Task* task = board.getTask(taskId);
+            if (task && matchesSearch(task)) {
+                createTaskCard(task);
+            }
+        }
+    }
+
+    showWarningIfUnassigned(); // Предупреждение о неназначеннных задачах
+    updateStatistics();
+    updateUndoActions();
+    scheduleDeadlineTimer();
+}
+
+void MainWindow::updateUndoActions() {
+    const UndoStack& undoStack = board.getUndoStack();
+    undoAction->setEnabled(undoStack.canUndo());
+    undoAction->setText(undoStack.canUndo() ? QString("Отменить: %1").arg(undoStack.undoText()) : "Отменить");
+    redoAction->setEnabled(undoStack.canRedo());
+    redoAction->setText(undoStack.canRedo() ? QString("Повторить: %1").arg(undoStack.redoText()) : "Повторить");
+}
 
+void MainWindow::onUndo() {
+    if (!board.undo()) {
+        statusBar()->showMessage("Не удалось отменить изменение", 3000);
+    }
+    refreshBoard();
+}
+
+void MainWindow::onRedo() {
+    if (!board.redo()) {
+        statusBar()->showMessage("Не удалось повторить изменение", 3000);
+    }
+    refreshBoard();
+}
+
+void MainWindow::scheduleDeadlineTimer() {
+    QDateTime next = board.nextDeadlineTransition();
+    if (!next.isValid()) {
+        deadlineTimer->stop();
+        return;
+    }
+    qint64 delay = QDateTime::currentDateTime().msecsTo(next);
+    deadlineTimer->start(int(qBound<qint64>(0, delay, deadlineTimerMaxMs)));
+}
+
+void MainWindow::rebuildBoard() {
+    TRACE_SCOPE("MainWindow::rebuildBoard");
     for (ColumnWidget* column : columns) {
         column->clearTasks();
     }
+    cards.clear();
 
     for (Task& task : board.getTasks()) {
-        qDebug() << "Обрабатываем задачу:" << task.getTitle();
-        qDebug() << "  Дедлайн есть:" << task.hasDeadline();
-        if (task.hasDeadline()) {
-            qDebug() << "  Дней до дедлайна:" << task.daysUntilDeadline();
+        // Пропуск задач, не соответствующих поисковому запросу
+        if (matchesSearch(&task)) {
+            createTaskCard(&task);
         }
+    }
+}
 
-        // Пропуск задач, не соответствующих поисковому запросу
-        if (!matchesSearch(&task)) {
-            continue;
+bool MainWindow::updateVirtualMode() {
+    int taskCount = board.getTasks().size();
+    bool wanted = virtualMode ? taskCount >= virtualModeLeaveThreshold
+                              : taskCount > virtualModeEnterThreshold;
+    if (wanted == virtualMode) {
+        return false;
+    }
+
+    virtualMode = wanted;
+    if (virtualMode) {
+        // Карточки-виджеты больше не нужны
+        for (ColumnWidget* column : columns) {
+            column->clearTasks();
         }
+        cards.clear();
+    }
+    for (TaskStatus status : columns.keys()) {
+        columns[status]->setVisible(!virtualMode);
+        virtualColumns[status]->setVisible(virtualMode);
+    }
+    return true;
+}
+
+void MainWindow::createTaskCard(Task* task) {
+    TaskCard* card = new TaskCard(task, &board, this); // Создание карточки для задачи
 
-        TaskCard* card = new TaskCard(&task, &board, this); // Создание карточки для задачи
+    connect(card, &TaskCard::editClicked, this, &MainWindow::onTaskEdit);
+    connect(card, &TaskCard::deleteClicked, this, &MainWindow::onTaskDelete);
+    connect(card, &TaskCard::statusChangeClicked, this, &MainWindow::onTaskStatusChange);
 
-        connect(card, &TaskCard::editClicked, this, &MainWindow::onTaskEdit);
-        connect(card, &TaskCard::deleteClicked, this, &MainWindow::onTaskDelete);
-        connect(card, &TaskCard::statusChangeClicked, this, &MainWindow::onTaskStatusChange);
+    columns[task->getStatus()]->addTaskCard(card);
+    cards.insert(task->getId(), card);
+}
 
-        columns[task.getStatus()]->addTaskCard(card);
+void MainWindow::removeTaskCard(int taskId) {
+    TaskCard* card = cards.take(taskId);
+    if (!card) {
+        return;
     }
+    // Карточка может быть источником текущего сигнала, поэтому удаляем её отложенно.
+    // setParent(nullptr) сразу убирает её из компоновки колонки
+    card->hide();
+    card->setParent(nullptr);
+    card->deleteLater();
+}
 
-    showWarningIfUnassigned(); // Предупреждение о неназначеннных задачах
-    updateStatistics();
+void MainWindow::applySearchFilter() {
+    TRACE_SCOPE("MainWindow::applySearchFilter");
+    refreshBoard(); // Сначала применяем накопленные изменения доски
+
+    if (virtualMode) {
+        for (VirtualColumnWidget* column : virtualColumns) {
+            column->model()->reload(); // Фильтр пересчитывается без создания виджетов
+        }
+        return;
+    }
+
+    for (Task& task : board.getTasks()) {
+        bool visible = matchesSearch(&task);
+        bool shown = cards.contains(task.getId());
+        if (visible && !shown) {
+            createTaskCard(&task);
+        } else if (!visible && shown) {
+            removeTaskCard(task.getId());
+        }
+    }
 }
 
 // Проверка соответствия задачи поисковому запросу
-bool MainWindow::matchesSearch(Task* task) {
+bool MainWindow::matchesSearch(const Task* task) const {
     if (searchFilter.isEmpty()) {
         return true;
     }
 
-    return task->getTitle().toLower().contains(searchFilter.toLower());     // Поиск по названию задачи (без учета регистра)
+    return searchMatches.contains(task->getId()); // Поиск по названию, описанию и истории через индекс доски
+}
+
+void MainWindow::updateSearchMatch(int taskId) {
+    bool matches = false;
+    if (searchQuery.isPlainText()) {
+        matches = !searchFilter.isEmpty() && board.taskMatchesSearch(taskId, searchFilter);
+    } else {
+        const Task* task = board.getTask(taskId);
+        matches = task && searchQuery.matches(board, *task);
+    }
+    if (matches) {
+        searchMatches.insert(taskId);
+    } else {
+        searchMatches.remove(taskId);
+    }
 }
 
 void MainWindow::onSearchTextChanged(const QString& text) {
-    searchFilter = text;
+    pendingSearch = text;
+    ++*searchGeneration; // Идущий поиск по старому запросу больше не нужен
+
+    if (text.isEmpty()) {
+        // Сброс фильтра не требует поиска - применяем сразу
+        searchTimer->stop();
+        searchInFlight = false;
+        searchFilter.clear();
+        searchMatches.clear();
+        searchQuery = BoardQuery();
+        searchBox->setToolTip(searchHelp);
+        applySearchFilter();
+        return;
+    }
+    searchTimer->start(); // Перезапуск таймера откладывает поиск до паузы в наборе
+}
+
+QString MainWindow::recoveryFilePath() {
+    QString dir = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir().mkpath(dir);
+    return dir + "/autosave.json";
+}
+
+QString MainWindow::recoveryBasePath() {
+    return recoveryFilePath() + ".base";
+}
+
+void MainWindow::resetRecovery(const QString& baseFile) {
+    // Журнал очищается первым, ссылка на файл пишется последней: сбой на любом шаге
+    // оставляет согласованную пару "основа + журнал" (старую или новую)
+    board.openJournal(recoveryFilePath(), true);
+    QFile::remove(recoveryFilePath());
+    QSaveFile base(recoveryBasePath());
+    if (base.open(QIODevice::WriteOnly)) {
+        base.write(baseFile.isEmpty() ? QByteArray() : QFileInfo(baseFile).absoluteFilePath().toUtf8());
+        if (base.commit()) {
+            return;
+        }
+    }
+    board.saveToFile(recoveryFilePath()); // Ссылку записать не удалось - нужен полный снимок
+}
+
+void MainWindow::startAutosave() {
+    const quint64 revision = board.getRevision();
+    if (autosaveInFlight || revision == savedRevision || revision == recoveryRevision) {
+        return; // Предыдущая запись ещё идёт или несохранённых изменений нет
+    }
+    // Файл пользователя не трогаем: снимок - только для восстановления
+    saveInBackground(recoveryFilePath(), false);
+}
+
+void MainWindow::saveInBackground(const QString& target, bool userRequested) {
+    // Снимок берётся в главном потоке и стоит O(число задач) копирований ссылок;
+    // сериализация и запись на диск идут в потоке autosavePool
+    BoardSnapshot snapshot = board.snapshot(target);
+    int generation = autosaveGeneration;
+    autosaveInFlight = true;
+    autosaveLabel->setText("💾 Автосохранение...");
+    autosaveProgress->setValue(0);
+    autosaveProgress->show();
+
+    QPointer<MainWindow> self(this);
+    autosavePool.start([self, snapshot, target, generation, userRequested]() {
+        bool ok = Board::saveSnapshot(snapshot, target, [self](int written, int total) {
+            int percent = total > 0 ? written * 100 / total : 100;
+            QMetaObject::invokeMethod(qApp, [self, percent]() {
+                if (self) {
+                    self->autosaveProgress->setValue(percent);
+                }
+            }, Qt::QueuedConnection);
+        });
+        // Результат обрабатывается в главном потоке
+        QMetaObject::invokeMethod(qApp, [self, generation, ok, target, snapshot, userRequested]() {
+            if (self) {
+                self->finishAutosave(generation, ok, target, snapshot.journalSequence, snapshot.revision, userRequested);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+void MainWindow::finishAutosave(int generation, bool ok, const QString& target, quint64 journalSequence,
+                                quint64 revision, bool userRequested) {
+    if (generation != autosaveGeneration) {
+        return; // Запись относилась к доске, которую уже заменили
+    }
+    autosaveInFlight = false;
+    autosaveProgress->hide();
+    if (!ok) {
+        autosaveLabel->setText("⚠️ Сохранение не удалось");
+        if (userRequested) {
+            QMessageBox::critical(this, "Ошибка", "Не удалось сохранить доску");
+        }
+        return;
+    }
+
+    const QString time = QTime::currentTime().toString("HH:mm");
+    if (userRequested) {
+        savedRevision = revision;
+        if (board.discardJournal(journalSequence)) {
+            // Всё несохранённое теперь в файле пользователя - он и становится основой журнала.
+            // Если доска менялась во время записи, файл восстановления и журнал остаются
+            resetRecovery(target);
+        }
+        autosaveLabel->setText(QString("💾 Сохранено в %1").arg(time));
+    } else {
+        recoveryRevision = revision;
+        // Снимок восстановления включает журнал - его можно очистить, если с тех пор ничего не менялось
+        board.discardJournal(journalSequence);
+        autosaveLabel->setText(QString("💾 Копия для восстановления: %1").arg(time));
+    }
+    if (userRequested) {
+        QMessageBox::information(this, "Успех", "Доска успешно сохранена");
+    }
+}
+
+void MainWindow::waitForAutosave() {
+    if (!autosaveInFlight) {
+        return;
+    }
+    autosavePool.waitForDone();
+    // Результат записи уже в очереди главного потока - обрабатываем его сразу,
+    // до того как доска изменится
+    QCoreApplication::sendPostedEvents(qApp, QEvent::MetaCall);
+}
+
+bool MainWindow::hasRecovery() {
+    QString path = recoveryFilePath();
+    return QFile::exists(path) || QFileInfo(BoardJournal::journalFileName(path)).size() > 0;
+}
+
+bool MainWindow::offerRecovery() {
+    // Снимок восстановления появляется только при автосохранении; без него журнал
+    // проигрывается поверх файла, который пользователь открыл или сохранил последним
+    QString path = recoveryFilePath();
+    bool hasSnapshot = QFile::exists(path);
+    bool restored = false;
+    if (hasRecovery()) {
+        QMessageBox::StandardButton reply = QMessageBox::question(
+            this, "Восстановление",
+            "Найдены несохранённые изменения доски с прошлого запуска. Восстановить их?",
+            QMessageBox::Yes | QMessageBox::No
+            );
+        QString snapshotFile = path;
+        if (!hasSnapshot) {
+            QFile base(recoveryBasePath());
+            snapshotFile = base.open(QIODevice::ReadOnly) ? QString::fromUtf8(base.readAll()) : QString();
+        }
+        restored = reply == QMessageBox::Yes && board.recoverFromFile(snapshotFile, path);
+    }
+    if (!restored) {
+        resetRecovery(QString());
+        return false;
+    }
+    board.openJournal(path); // Дальнейшие изменения дописываются к тому же журналу
+    savedRevision = 0;       // Восстановленная доска ещё не сохранена пользователем
+    recoveryRevision = board.getRevision();
+    searchBox->clear();
     refreshBoard();
+    return true;
 }
 
-void MainWindow::updateStatistics() {
-    // Подсчет задач по статусам
-    int backlog = board.getTasksByStatus(TaskStatus::Backlog).size();
-    int assigned = board.getTasksByStatus(TaskStatus::Assigned).size();
-    int inProgress = board.getTasksByStatus(TaskStatus::InProgress).size();
-    int review = board.getTasksByStatus(TaskStatus::Review).size();
-    int done = board.getTasksByStatus(TaskStatus::Done).size();
-    int total = board.getTasks().size();
+void MainWindow::startSearch() {
+    int generation = ++*searchGeneration;
+    QString query = pendingSearch;
+    board.indexHistory(); // История из *.sbb попадает в индекс при первом поиске, а не при загрузке
+
+    // Запрос с полями выполняется сразу: планировщик доски берёт задачи из индексов.
+    // Текст, который не разобрался как запрос, ищется как обычный текст
+    BoardQuery parsed;
+    QString error;
+    if (BoardQuery::parse(query, parsed, &error) && !parsed.isPlainText()) {
+        board.updateDeadlines(); // is:overdue - на текущий момент
+        QueryResult result = board.query(parsed);
+        statusBar()->showMessage(QString("Найдено задач: %1").arg(result.ids.size()), 3000);
+        searchBox->setToolTip(result.plan); // Объяснение плана - во всплывающей подсказке
+        changedDuringSearch.clear();
+        applySearchResult(generation, query, parsed, result.ids);
+        return;
+    }
+    if (!error.isEmpty()) {
+        statusBar()->showMessage("Запрос не разобран (" + error + "), ищется как текст", 3000);
+    } else {
+        query = parsed.plainText(); // Кавычки - часть синтаксиса, а не искомого текста
+    }
+    searchBox->setToolTip(searchHelp);
+
+    SearchIndex snapshot = board.getSearchIndex(); // Копия разделяет данные с оригиналом (copy-on-write)
+    searchInFlight = true;
+    changedDuringSearch.clear();
+
+    std::shared_ptr<std::atomic<int>> latest = searchGeneration;
+    QPointer<MainWindow> self(this);
+    QThreadPool::globalInstance()->start([snapshot, query, generation, latest, self]() {
+        TRACE_SCOPE("MainWindow::startSearch (поток)");
+        QSet<int> candidates;
+        QSet<int> matches = snapshot.search(query, [latest, generation]() {
+            return latest->load() != generation;
+        }, &candidates);
+        if (latest->load() != generation) {
+            return; // Пока искали, пользователь набрал новый запрос
+        }
+        // Результат применяется в главном потоке; там же читается история кандидатов
+        QMetaObject::invokeMethod(qApp, [self, generation, query, matches, candidates]() {
+            if (self && generation == self->searchGeneration->load()) {
+                QSet<int> found = matches;
+                found.unite(self->board.matchHistory(candidates, query));
+                self->applySearchResult(generation, query, BoardQuery(), found);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
 
-    int percentDone = total > 0 ? (done * 100 / total) : 0;
+void MainWindow::applySearchResult(int generation, const QString& text, const BoardQuery& query,
+                                   const QSet<int>& matches) {
+    if (generation != searchGeneration->load()) {
+        return;
+    }
+    TRACE_SCOPE("MainWindow::applySearchResult");
+
+    searchInFlight = false;
+    searchFilter = text;
+    searchQuery = query;
+    searchMatches = matches;
+    // Снимок индекса не видел изменений, сделанных во время поиска
+    for (int taskId : changedDuringSearch) {
+        updateSearchMatch(taskId);
+    }
+    changedDuringSearch.clear();
+
+    applySearchFilter(); // Пересоздаются только карточки, сменившие видимость
+}
+
+void MainWindow::updateStatistics() {
+    // Счётчики поддерживаются доской, перебор задач не нужен
+    const BoardStats& boardStats = board.getStats();
 
     QString stats = QString("📊 Всего: %1 | Выполнено: %2 (%3%)")
-                        .arg(total)
-                        .arg(done)
-                        .arg(percentDone);
+                        .arg(boardStats.total)
+                        .arg(boardStats.count(TaskStatus::Done))
+                        .arg(boardStats.percentDone());
 
     statsLabel->setText(stats);
 }
@@ -228,7 +722,10 @@ void MainWindow::onNewBoard() {
         );
 
     if (reply == QMessageBox::Yes) {
+        waitForAutosave();
         board.clear();
+        resetRecovery(QString());
+        savedRevision = board.getRevision();
         searchBox->clear();
         refreshBoard();
         QMessageBox::information(this, "Успех", "Новая доска создана");
@@ -237,21 +734,22 @@ void MainWindow::onNewBoard() {
 
 void MainWindow::onSaveBoard() {
     QString filename = QFileDialog::getSaveFileName(
-        this, "Сохранить доску", "", "JSON Files (*.json)"
+        this, "Сохранить доску", "", "JSON Files (*.json);;Binary Board Files (*.sbb)"
         );
 
-    if (!filename.isEmpty()) {
-        if (board.saveToFile(filename)) {
-            QMessageBox::information(this, "Успех", "Доска успешно сохранена");
-        } else {
-            QMessageBox::critical(this, "Ошибка", "Не удалось сохранить доску");
-        }
+    if (filename.isEmpty()) {
+        return;
     }
+    waitForAutosave(); // Снимки пишутся по одному
+
+    // Файл пишется целиком в фоне; окно при этом остаётся отзывчивым. Журнал в файл
+    // пользователя не пишется: он живёт рядом с файлом восстановления
+    saveInBackground(filename, true);
 }
 
 void MainWindow::onLoadBoard() {
     QString filename = QFileDialog::getOpenFileName(
-        this, "Загрузить доску", "", "JSON Files (*.json)"
+        this, "Загрузить доску", "", "Board Files (*.json *.sbb);;JSON Files (*.json);;Binary Board Files (*.sbb)"
         );
 
     if (!filename.isEmpty()) {
@@ -261,7 +759,23 @@ void MainWindow::onLoadBoard() {
 
 // Загрузка доски из указанного файла
 void MainWindow::loadBoard(const QString& filePath) {
-    if (board.loadFromFile(filePath)) {
+    TRACE_SCOPE("MainWindow::loadBoard");
+    waitForAutosave();
+    // Прогресс показывается, только если загрузка заметно затянулась
+    QProgressDialog progressDialog("Загрузка доски...", QString(), 0, 100, this);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
+
+    bool loaded = board.loadFromFile(filePath, [&progressDialog](qint64 bytesRead, qint64 totalBytes) {
+        if (totalBytes > 0) {
+            progressDialog.setValue(int(bytesRead * 100 / totalBytes));
+        }
+    });
+    progressDialog.reset();
+
+    if (loaded) {
+        resetRecovery(filePath); // Изменения - в журнал восстановления; файл пользователя не меняется до сохранения
+        savedRevision = board.getRevision();
         searchBox->clear();
         refreshBoard();
         QMessageBox::information(this, "Успех", "Доска успешно загружена");
@@ -272,6 +786,7 @@ void MainWindow::loadBoard(const QString& filePath) {
 
 void MainWindow::onAddDeveloper() {
     QDialog dialog(this);
+    TRACE_BEGIN(dialogSpan, "MainWindow::onAddDeveloper (диалог)");
     dialog.setWindowTitle("Добавить разработчика");
 
     QFormLayout* layout = new QFormLayout(&dialog);
@@ -292,6 +807,7 @@ void MainWindow::onAddDeveloper() {
     connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
 
     // Если пользователь нажал OK
+    TRACE_END(dialogSpan); // Замеряем построение диалога, а не время работы пользователя с ним
     if (dialog.exec() == QDialog::Accepted) {
         QString name = nameEdit->text().trimmed();
         QString position = positionEdit->text().trimmed();
@@ -301,14 +817,15 @@ void MainWindow::onAddDeveloper() {
             return;
         }
 
-        Developer dev(name, position);
-        board.addDeveloper(dev);
+        board.createDeveloper(name, position); // ID из счётчика доски
+        updateUndoActions();
         QMessageBox::information(this, "Успех", "Разработчик добавлен");
     }
 }
 
 void MainWindow::onManageDevelopers() {
     QDialog dialog(this);
+    TRACE_BEGIN(dialogSpan, "MainWindow::onManageDevelopers (диалог)");
     dialog.setWindowTitle("Управление разработчиками");
     dialog.resize(400, 300);
 
@@ -356,6 +873,7 @@ void MainWindow::onManageDevelopers() {
     layout->addWidget(closeBtn);
     connect(closeBtn, &QPushButton::clicked, &dialog, &QDialog::accept);
 
+    TRACE_END(dialogSpan);
     dialog.exec();
 }
 
@@ -368,8 +886,28 @@ void MainWindow::onTaskDropped(int taskId, TaskStatus newStatus) {
     }
 }
 
+void MainWindow::onCompleteReviewed() {
+    QVector<BoardOperation> operations;
+    for (Task* task : board.getTasksByStatus(TaskStatus::Review)) {
+        operations.append(BoardOperation::setStatus(task->getId(), TaskStatus::Done));
+    }
+    if (operations.isEmpty()) {
+        QMessageBox::information(this, "Задачи", "Нет задач на проверке");
+        return;
+    }
+
+    // Пакет обновляет индексы и журнал один раз, а доска перерисовывается один раз
+    QString error;
+    if (!board.applyBatch(operations, &error)) {
+        QMessageBox::warning(this, "Ошибка", error);
+        return;
+    }
+    refreshBoard();
+}
+
 void MainWindow::onAddTask() {
     QDialog dialog(this);
+    TRACE_BEGIN(dialogSpan, "MainWindow::onAddTask (диалог)");
     dialog.setWindowTitle("Добавить задачу");
 
     QFormLayout* layout = new QFormLayout(&dialog);
@@ -417,6 +955,7 @@ void MainWindow::onAddTask() {
     connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
     connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
 
+    TRACE_END(dialogSpan);
     if (dialog.exec() == QDialog::Accepted) {
         QString title = titleEdit->text().trimmed();
         QString desc = descEdit->toPlainText().trimmed();
@@ -426,15 +965,16 @@ void MainWindow::onAddTask() {
             return;
         }
 
-        Task task(title, desc);  // Создание задачи
+        board.beginUndoStep(QString("Добавление задачи «%1»").arg(title)); // Задача с дедлайном - один шаг
+        Task* task = board.createTask(title, desc);  // Создание задачи с ID из счётчика доски
 
         // Устанавливаем дедлайн если выбран
         if (hasDeadlineCheck->isChecked()) {
             QDateTime deadline(deadlineEdit->date(), QTime(23, 59, 59)); // Дедлайн до конца дня
-            task.setDeadline(deadline);
+            task->setDeadline(deadline);
         }
+        board.endUndoStep();
 
-        board.addTask(task);
         refreshBoard();
         QMessageBox::information(this, "Успех", "Задача добавлена в бэклог");
     }
@@ -444,6 +984,7 @@ void MainWindow::onTaskEdit(Task* task) {
     if (!task) return;
 
     QDialog dialog(this);
+    TRACE_BEGIN(dialogSpan, "MainWindow::onTaskEdit (диалог)");
     dialog.setWindowTitle("Редактировать задачу");
 
     QFormLayout* layout = new QFormLayout(&dialog);
@@ -520,7 +1061,10 @@ void MainWindow::onTaskEdit(Task* task) {
     connect(buttons, &QDialogButtonBox::accepted, &dialog, &QDialog::accept);
     connect(buttons, &QDialogButtonBox::rejected, &dialog, &QDialog::reject);
 
+    TRACE_END(dialogSpan);
     if (dialog.exec() == QDialog::Accepted) {
+        // Все правки из диалога отменяются одним шагом
+        board.beginUndoStep(QString("Редактирование задачи «%1»").arg(task->getTitle()));
         task->setTitle(titleEdit->text().trimmed());
         task->setDescription(descEdit->toPlainText().trimmed());
 
@@ -537,6 +1081,7 @@ void MainWindow::onTaskEdit(Task* task) {
         } else {
             task->setDeadline(QDateTime());
         }
+        board.endUndoStep();
 
         refreshBoard();
     }
@@ -585,19 +1130,24 @@ void MainWindow::onTaskStatusChange(Task* task) {
 
 void MainWindow::onShowStatistics() {
     QDialog dialog(this);
+    TRACE_BEGIN(dialogSpan, "MainWindow::onShowStatistics (диалог)");
     dialog.setWindowTitle("Статистика доски");
     dialog.resize(500, 400);
 
     QVBoxLayout* layout = new QVBoxLayout(&dialog);
 
-    int backlog = board.getTasksByStatus(TaskStatus::Backlog).size();
-    int assigned = board.getTasksByStatus(TaskStatus::Assigned).size();
-    int inProgress = board.getTasksByStatus(TaskStatus::InProgress).size();
-    int review = board.getTasksByStatus(TaskStatus::Review).size();
-    int done = board.getTasksByStatus(TaskStatus::Done).size();
-    int total = board.getTasks().size();
+    // Корзины дедлайнов считаются на момент последнего updateDeadlines(): refreshBoard()
+    // вызывает его и заодно обновляет подсветку карточек, сменивших срочность
+    refreshBoard();
+    const BoardStats& stats = board.getStats();
+    int backlog = stats.count(TaskStatus::Backlog);
+    int assigned = stats.count(TaskStatus::Assigned);
+    int inProgress = stats.count(TaskStatus::InProgress);
+    int review = stats.count(TaskStatus::Review);
+    int done = stats.count(TaskStatus::Done);
+    int total = stats.total;
 
-    int percentDone = total > 0 ? (done * 100 / total) : 0;
+    int percentDone = stats.percentDone();
 
     QLabel* titleLabel = new QLabel("<h2>📊 Статистика проекта</h2>", &dialog);
     layout->addWidget(titleLabel);
@@ -632,22 +1182,9 @@ void MainWindow::onShowStatistics() {
     layout->addSpacing(10);
     
     // Статистика по дедлайнам
-    int overdueCount = 0; // Просроченные задачи
-    int todayCount = 0;  // Дедлайн сегодня
-    int soonCount = 0; // Дедлайн в ближайшие 1-3 дня
-
-    // Подсчет задач по срочности дедлайнов
-    for (const Task& task : board.getTasks()) {
-        if (task.hasDeadline() && task.getStatus() != TaskStatus::Done) {
-            if (task.isOverdue()) {
-                overdueCount++;
-            } else if (task.daysUntilDeadline() == 0) {
-                todayCount++;
-            } else if (task.daysUntilDeadline() <= 3) {
-                soonCount++;
-            }
-        }
-    }
+    int overdueCount = stats.overdue; // Просроченные задачи
+    int todayCount = stats.dueToday;  // Дедлайн сегодня
+    int soonCount = stats.dueSoon; // Дедлайн в ближайшие 1-3 дня
 
     QLabel* deadlineHeader = new QLabel("<b>Дедлайны:</b>", &dialog);
     layout->addWidget(deadlineHeader);
@@ -691,7 +1228,7 @@ void MainWindow::onShowStatistics() {
     int maxTasks = 0;
     QString topDev = "—";
     for (const Developer& dev : board.getDevelopers()) {
-        int taskCount = board.getTasksByDeveloper(dev.getId()).size();
+        int taskCount = board.countTasksByDeveloper(dev.getId());
         if (taskCount > maxTasks) {
             maxTasks = taskCount;
             topDev = dev.getName();
@@ -712,5 +1249,6 @@ void MainWindow::onShowStatistics() {
     connect(closeBtn, &QPushButton::clicked, &dialog, &QDialog::accept);
     layout->addWidget(closeBtn);
 
+    TRACE_END(dialogSpan);
     dialog.exec();
 }
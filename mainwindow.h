@@ -3,10 +3,17 @@
 
 #include <QMainWindow>
 #include <QMap>         // Контейнер для хранения пар ключ-значение
+#include <QHash>
 #include <QLineEdit>    // Виджет для однострочного текстового ввода (поиск)
 #include <QLabel>       // Виджет для отображения текста (статистика)
+#include <QTimer>       // Таймер для отложенного поиска
+#include <QThreadPool>  // Отдельный поток для автосохранения
+#include <QProgressBar> // Ход автосохранения в строке состояния
+#include <atomic>
+#include <memory>
 #include "models/board.h"
 #include "widgets/columnwidget.h"
+#include "widgets/virtualcolumnwidget.h"
 
 QT_BEGIN_NAMESPACE // Начало пространства имен Qt (нужно для Ui класса)
 namespace Ui {
@@ -14,6 +21,8 @@ class MainWindow; // Предварительное объявление кла
 }
 QT_END_NAMESPACE // Конец пространства имен Qt
 
+class TaskCard;
+
 class MainWindow : public QMainWindow {
     Q_OBJECT // Макрос Qt для включения механизма сигналов и слотов
 
@@ -24,6 +33,11 @@ public:
 
     void loadBoard(const QString& filePath); //filePath - путь к файлу с сохраненной доской
 
+    // Несохранённые изменения прошлого запуска. Их предлагают восстановить один раз при запуске
+    // программы, до выбора доски: offerRecovery() возвращает true, если доска восстановлена
+    static bool hasRecovery();
+    bool offerRecovery();
+
 signals:
     void backToStartScreen();
 
@@ -33,6 +47,9 @@ private slots:
     void onLoadBoard();
     void onAddDeveloper();
     void onAddTask();
+    void onCompleteReviewed(); // Перевести все задачи из Review в Done одним пакетом
+    void onUndo();
+    void onRedo();
     void onManageDevelopers();
     void onShowStatistics();
 
@@ -41,6 +58,8 @@ private slots:
     void onTaskStatusChange(Task* task);
 
     void onSearchTextChanged(const QString& text);
+    void startAutosave(); // Сохранить снимок доски в фоне, если она изменилась
+    void startSearch(); // Запуск отложенного поиска в фоновом потоке
     void onTaskDropped(int taskId, TaskStatus newStatus);
 
 private:
@@ -51,18 +70,76 @@ private:
     // Ключ: TaskStatus (например, TODO, IN_PROGRESS, DONE)
     // Значение: ColumnWidget* - виджет, отображающий задачи данного статуса
     QMap<TaskStatus, ColumnWidget*> columns;
+    // Карточки на доске: ID задачи → карточка (только задачи, прошедшие фильтр поиска)
+    QHash<int, TaskCard*> cards;
+
+    // Виртуализированные колонки для больших досок (показываются вместо columns)
+    QMap<TaskStatus, VirtualColumnWidget*> virtualColumns;
+    bool virtualMode = false;
     QLineEdit* searchBox;
     QLabel* statsLabel;
 
-    QString searchFilter;
+    QString searchFilter;    // Применённый поисковый запрос
+    QSet<int> searchMatches; // ID задач, найденных по searchFilter через индекс доски
+    BoardQuery searchQuery;  // Разобранный searchFilter, если это запрос с полями или операторами
+
+    // Фоновый поиск: запрос запускается после паузы в наборе, а номер поколения
+    // позволяет отбросить (и прервать) устаревший поиск при новом нажатии клавиши
+    QTimer* searchTimer;
+    QString pendingSearch;
+    std::shared_ptr<std::atomic<int>> searchGeneration;
+    bool searchInFlight = false;
+    QSet<int> changedDuringSearch; // Задачи, изменённые после снимка индекса
+
+    QTimer* journalTimer; // Периодическая синхронизация журнала изменений доски
+
+    // Отмена и повтор изменений доски (текст пунктов - название шага)
+    QAction* undoAction;
+    QAction* redoAction;
+    void updateUndoActions();
+
+    // Срабатывает, когда ближайшая задача сменит срочность (наступит дедлайн или полночь)
+    QTimer* deadlineTimer;
+    void scheduleDeadlineTimer();
+
+    // Автосохранение: снимок доски пишется в отдельном потоке (один за раз) и только
+    // в файл восстановления; "Сохранить" пишет так же, но в файл пользователя
+    QTimer* autosaveTimer;
+    QThreadPool autosavePool;
+    bool autosaveInFlight = false;
+    int autosaveGeneration = 0; // Результаты записей, начатых до закрытия окна, игнорируются
+    quint64 savedRevision = 0;    // Версия доски, сохранённая пользователем в файл
+    quint64 recoveryRevision = 0; // Версия доски в снимке восстановления
+    QLabel* autosaveLabel;
+    QProgressBar* autosaveProgress;
+
+    // Файл восстановления и его журнал: изменения, которых ещё нет в файле пользователя.
+    // Сам файл пользователя меняется только командой "Сохранить". Пока автосохранение
+    // не записало снимок, основой журнала служит файл из recoveryBasePath()
+    static QString recoveryFilePath();
+    static QString recoveryBasePath();
+    // Начать восстановление заново: доска совпадает с baseFile (загружена или сохранена;
+    // пустое имя - новая доска)
+    void resetRecovery(const QString& baseFile);
+    void saveInBackground(const QString& target, bool userRequested);
+    void finishAutosave(int generation, bool ok, const QString& target, quint64 journalSequence,
+                        quint64 revision, bool userRequested);
+    void waitForAutosave(); // Дождаться фоновой записи перед сменой/сохранением доски
 
     void setupUI(); // Настройка основного интерфейса
     void setupMenuBar();  // Создание и настройка меню (File, Edit, View и т.д.)
     void setupToolBar();  // Создание и настройка панели инструментов (кнопки быстрого доступа)
-    void refreshBoard(); // Полное обновление отображения доски (перерисовка всех столбцов и задач)
+    void refreshBoard(); // Обновление отображения: пересоздаются только карточки изменившихся задач
+    void rebuildBoard(); // Полная перерисовка всех столбцов и задач
+    void applySearchFilter(); // Показать/скрыть карточки после смены поискового запроса
+    void applySearchResult(int generation, const QString& text, const BoardQuery& query, const QSet<int>& matches);
+    void updateSearchMatch(int taskId); // Перепроверить одну задачу по текущему запросу
+    void createTaskCard(Task* task);
+    void removeTaskCard(int taskId);
+    bool updateVirtualMode(); // Переключение режима по размеру доски; true - режим сменился
     void updateStatistics();  // Обновление статистики (отображается в statsLabel)
     void showWarningIfUnassigned();   // Проверка наличия неприсвоенных задач и вывод предупреждения
-    bool matchesSearch(Task* task);  // Проверка, соответствует ли задача текущему поисковому запросу
+    bool matchesSearch(const Task* task) const;  // Проверка, соответствует ли задача текущему поисковому запросу
 };
 
 #endif // MAINWINDOW_H
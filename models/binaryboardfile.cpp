@@ -0,0 +1,326 @@
+#include "binaryboardfile.h"
+#include <QDataStream>
+#include <QFileInfo>
+#include <QHash>
+#include <QSaveFile>
+#include <QtEndian>
+#include <cstring>
+#include <limits>
+
+const char* BinaryBoardFile::extension = "sbb";
+
+namespace {
+
+const char magic[4] = {'S', 'C', 'R', 'B'};
+const quint32 formatVersion = 2;
+const quint32 textHistoryVersion = 1; // История в виде строк действия и подробностей
+
+const int headerSize = 64;
+const int developerRecordSize = 12;
+const int taskRecordSize = 48;
+const int historyRecordSize = 32;     // Версия 2: компактная запись TaskHistoryEntry
+const int textHistoryRecordSize = 16; // Версия 1
+const quint32 nullString = 0xFFFFFFFF; // Вместо номера строки: QString() (не пустая строка)
+const int stringEntrySize = 12;
+
+const qint64 noDateTime = std::numeric_limits<qint64>::min(); // Дедлайн не задан
+
+qint64 encodeDateTime(const QDateTime& dateTime) {
+    return dateTime.isValid() ? dateTime.toMSecsSinceEpoch() : noDateTime;
+}
+
+QDateTime decodeDateTime(qint64 msecs) {
+    return msecs == noDateTime ? QDateTime() : QDateTime::fromMSecsSinceEpoch(msecs);
+}
+
+template <typename T>
+T readLE(const uchar* p) {
+    return qFromLittleEndian<T>(p);
+}
+
+// Таблица строк при записи: каждая различная строка сохраняется один раз
+class StringTable {
+public:
+    quint32 add(const QString& text) {
+        auto it = indexes.constFind(text);
+        if (it != indexes.constEnd()) {
+            return it.value();
+        }
+        quint32 index = quint32(utf8.size());
+        indexes.insert(text, index);
+        utf8.append(text.toUtf8());
+        return index;
+    }
+
+    QHash<QString, quint32> indexes;
+    QList<QByteArray> utf8;
+};
+
+} // namespace
+
+bool BinaryBoardFile::isBinaryFileName(const QString& filename) {
+    return QFileInfo(filename).suffix().compare(extension, Qt::CaseInsensitive) == 0;
+}
+
+bool BinaryBoardFile::write(const QString& filename, const QList<Developer>& developers, const QList<Task>& tasks,
+                            quint64 journalSequence, const std::function<void(int, int)>& progress) {
+    // Сначала собираем таблицу строк, чтобы знать смещения всех разделов
+    StringTable strings;
+    QVector<quint32> devStrings;
+    devStrings.reserve(developers.size() * 2);
+    for (const Developer& dev : developers) {
+        devStrings.append(strings.add(dev.getName()));
+        devStrings.append(strings.add(dev.getPosition()));
+    }
+
+    QVector<quint32> taskStrings;
+    QVector<quint32> historyStrings; // text и text2 каждой записи
+    taskStrings.reserve(tasks.size() * 2);
+    for (const Task& task : tasks) {
+        taskStrings.append(strings.add(task.getTitle()));
+        taskStrings.append(strings.add(task.getDescription()));
+        for (const TaskHistoryEntry& entry : task.getHistory()) {
+            const QString text = entry.text();
+            const QString text2 = entry.text2();
+            historyStrings.append(text.isNull() ? nullString : strings.add(text));
+            historyStrings.append(text2.isNull() ? nullString : strings.add(text2));
+        }
+    }
+
+    const quint32 historyTotal = quint32(historyStrings.size() / 2);
+    const quint64 developersOffset = headerSize;
+    const quint64 tasksOffset = developersOffset + quint64(developers.size()) * developerRecordSize;
+    const quint64 historyOffset = tasksOffset + quint64(tasks.size()) * taskRecordSize;
+    const quint64 stringIndexOffset = historyOffset + quint64(historyTotal) * historyRecordSize;
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    QDataStream out(&file);
+    out.setByteOrder(QDataStream::LittleEndian);
+
+    // Заголовок
+    out.writeRawData(magic, sizeof(magic));
+    out << formatVersion << quint32(developers.size()) << quint32(tasks.size())
+        << historyTotal << quint32(strings.utf8.size())
+        << developersOffset << tasksOffset << historyOffset << stringIndexOffset << journalSequence;
+
+    for (int i = 0; i < developers.size(); i++) {
+        out << qint32(developers[i].getId()) << devStrings[i * 2] << devStrings[i * 2 + 1];
+    }
+
+    quint32 firstHistory = 0;
+    for (int i = 0; i < tasks.size(); i++) {
+        const Task& task = tasks[i];
+        const quint32 historyCount = quint32(task.getHistory().size());
+        out << qint32(task.getId()) << taskStrings[i * 2] << taskStrings[i * 2 + 1]
+            << quint8(task.getStatus()) << quint8(0) << quint16(0)
+            << qint32(task.getAssignedDeveloperId()) << quint32(0)
+            << encodeDateTime(task.getDeadline())
+            << firstHistory << historyCount << quint64(0);
+        firstHistory += historyCount;
+    }
+
+    // Основная работа - записи истории; ход записи считаем по задачам
+    const int progressStepTasks = qMax(1, tasks.size() / 100);
+    int h = 0;
+    for (int i = 0; i < tasks.size(); i++) {
+        for (const TaskHistoryEntry& entry : tasks[i].getHistory()) {
+            out << entry.timestampMs << entry.value() << quint8(entry.getActionCode()) << quint8(0) << quint16(0)
+                << historyStrings[h * 2] << historyStrings[h * 2 + 1] << quint32(0);
+            h++;
+        }
+        if (progress && (i + 1) % progressStepTasks == 0) {
+            progress(i + 1, tasks.size());
+        }
+    }
+
+    // Таблица строк: (смещение от начала файла, длина), затем сами данные
+    quint64 stringOffset = stringIndexOffset + quint64(strings.utf8.size()) * stringEntrySize;
+    for (const QByteArray& bytes : strings.utf8) {
+        out << stringOffset << quint32(bytes.size());
+        stringOffset += bytes.size();
+    }
+    for (const QByteArray& bytes : strings.utf8) {
+        out.writeRawData(bytes.constData(), bytes.size());
+    }
+
+    if (out.status() != QDataStream::Ok) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+BinaryBoardFile::BinaryBoardFile(const QString& filename)
+    : file(filename) {
+}
+
+bool BinaryBoardFile::fail(const QString& text) {
+    errorText = text;
+    data = nullptr;
+    return false;
+}
+
+bool BinaryBoardFile::open() {
+    if (!file.open(QIODevice::ReadOnly)) {
+        return fail(file.errorString());
+    }
+    size = file.size();
+    if (size < headerSize) {
+        return fail("файл слишком короткий");
+    }
+    data = file.map(0, size);
+    if (!data) {
+        return fail("не удалось отобразить файл в память");
+    }
+    if (std::memcmp(data, magic, sizeof(magic)) != 0) {
+        return fail("неверная сигнатура файла");
+    }
+    version = readLE<quint32>(data + 4);
+    if (version != formatVersion && version != textHistoryVersion) {
+        return fail(QString("неподдерживаемая версия формата %1").arg(version));
+    }
+    const int historySize = version == formatVersion ? historyRecordSize : textHistoryRecordSize;
+
+    developerTotal = readLE<quint32>(data + 8);
+    taskTotal = readLE<quint32>(data + 12);
+    historyTotal = readLE<quint32>(data + 16);
+    stringTotal = readLE<quint32>(data + 20);
+    developersOffset = readLE<quint64>(data + 24);
+    tasksOffset = readLE<quint64>(data + 32);
+    historyOffset = readLE<quint64>(data + 40);
+    stringIndexOffset = readLE<quint64>(data + 48);
+    sequence = readLE<quint64>(data + 56);
+
+    // Файл может быть повреждён: все разделы должны целиком лежать внутри него
+    auto fits = [this](quint64 offset, quint64 count, quint64 recordSize) {
+        return offset <= quint64(size) && count <= (quint64(size) - offset) / recordSize;
+    };
+    if (developerTotal > quint32(std::numeric_limits<int>::max())
+        || taskTotal > quint32(std::numeric_limits<int>::max())
+        || !fits(developersOffset, developerTotal, developerRecordSize)
+        || !fits(tasksOffset, taskTotal, taskRecordSize)
+        || !fits(historyOffset, historyTotal, historySize)
+        || !fits(stringIndexOffset, stringTotal, stringEntrySize)) {
+        return fail("повреждённый заголовок");
+    }
+    // Строки записаны подряд до конца файла: обрезанный файл видно по последней.
+    // Остальные ссылки (строки, диапазоны истории) проверяются при обращении
+    if (stringTotal > 0 && !stringFits(stringTotal - 1)) {
+        return fail("повреждённая таблица строк");
+    }
+    return true;
+}
+
+bool BinaryBoardFile::stringFits(quint32 index) const {
+    const uchar* entry = data + stringIndexOffset + quint64(index) * stringEntrySize;
+    const quint64 offset = readLE<quint64>(entry);
+    return offset <= quint64(size) && readLE<quint32>(entry + 8) <= quint64(size) - offset;
+}
+
+QString BinaryBoardFile::string(quint32 index) const {
+    if (!data || index >= stringTotal || !stringFits(index)) {
+        return QString(); // В том числе nullString и ссылки повреждённого файла
+    }
+    const uchar* entry = data + stringIndexOffset + quint64(index) * stringEntrySize;
+    const char* text = reinterpret_cast<const char*>(data + readLE<quint64>(entry));
+    return QString::fromUtf8(text, int(readLE<quint32>(entry + 8)));
+}
+
+Developer BinaryBoardFile::developer(int index) const {
+    Developer dev(0); // ID и поля берутся из записи
+    if (!data || index < 0 || index >= int(developerTotal)) {
+        return dev;
+    }
+    const uchar* record = data + developersOffset + quint64(index) * developerRecordSize;
+    dev.id = readLE<qint32>(record);
+    dev.name = string(readLE<quint32>(record + 4));
+    dev.position = string(readLE<quint32>(record + 8));
+    return dev;
+}
+
+const uchar* BinaryBoardFile::taskRecord(int index) const {
+    return data + tasksOffset + quint64(index) * taskRecordSize;
+}
+
+quint32 BinaryBoardFile::historyCount(const uchar* record) const {
+    const quint64 first = readLE<quint32>(record + 32);
+    const quint32 count = readLE<quint32>(record + 36);
+    return first + count <= historyTotal ? count : 0; // Диапазон вне раздела истории - файл повреждён
+}
+
+Task BinaryBoardFile::task(int index, HistoryMode mode) const {
+    Task task(0); // ID и поля берутся из записи
+    if (!data || index < 0 || index >= int(taskTotal)) {
+        return task;
+    }
+    const uchar* record = taskRecord(index);
+    task.id = readLE<qint32>(record);
+    task.title = string(readLE<quint32>(record + 4));
+    task.description = string(readLE<quint32>(record + 8));
+    quint8 status = record[12];
+    task.status = status <= quint8(TaskStatus::Done) ? TaskStatus(status) : TaskStatus::Backlog;
+    task.assignedDeveloperId = readLE<qint32>(record + 16);
+    task.deadline = decodeDateTime(readLE<qint64>(record + 24));
+    if (mode == HistoryMode::Lazy) {
+        // Ссылаться на файл можно, только если им владеет shared_ptr
+        std::shared_ptr<const BinaryBoardFile> self = weak_from_this().lock();
+        if (self) {
+            task.history = TaskHistory(self, index, int(historyCount(record)));
+        } else {
+            mode = HistoryMode::Load;
+        }
+    }
+    if (mode == HistoryMode::Load) {
+        for (const TaskHistoryEntry& entry : history(index)) {
+            task.history.append(entry);
+        }
+    }
+    return task;
+}
+
+QList<TaskHistoryEntry> BinaryBoardFile::history(int taskIndex) const {
+    QList<TaskHistoryEntry> entries;
+    if (!data || taskIndex < 0 || taskIndex >= int(taskTotal)) {
+        return entries;
+    }
+    const uchar* record = taskRecord(taskIndex);
+    const quint32 first = readLE<quint32>(record + 32);
+    const quint32 count = historyCount(record);
+    entries.reserve(int(count));
+    for (quint32 i = 0; i < count; i++) {
+        entries.append(decodeHistory(quint64(first) + i));
+    }
+    return entries;
+}
+
+TaskHistoryEntry BinaryBoardFile::historyEntry(int key, int index) const {
+    if (!data || key < 0 || key >= int(taskTotal)) {
+        return TaskHistoryEntry();
+    }
+    const uchar* record = taskRecord(key);
+    if (index < 0 || quint32(index) >= historyCount(record)) {
+        return TaskHistoryEntry();
+    }
+    return decodeHistory(quint64(readLE<quint32>(record + 32)) + quint32(index));
+}
+
+TaskHistoryEntry BinaryBoardFile::decodeHistory(quint64 record) const {
+    if (version == textHistoryVersion) {
+        // Файлы версии 1 хранят готовый текст - распознаём стандартные действия
+        const uchar* entry = data + historyOffset + record * textHistoryRecordSize;
+        return TaskHistoryEntry::fromText(readLE<qint64>(entry), string(readLE<quint32>(entry + 8)),
+                                          string(readLE<quint32>(entry + 12)));
+    }
+    const uchar* entry = data + historyOffset + record * historyRecordSize;
+    TaskHistoryEntry item;
+    item.timestampMs = readLE<qint64>(entry);
+    quint8 code = entry[16];
+    item.setActionCode(code <= quint8(HistoryAction::DeadlineRemoved) ? HistoryAction(code) : HistoryAction::Custom);
+    item.setValue(readLE<qint64>(entry + 8));
+    // nullString вне таблицы - даёт QString()
+    item.setTexts(string(readLE<quint32>(entry + 20)), string(readLE<quint32>(entry + 24)));
+    return item;
+}
@@ -0,0 +1,93 @@
+#ifndef BINARYBOARDFILE_H
+#define BINARYBOARDFILE_H
+
+#include <QFile>
+#include <QList>
+#include <QString>
+#include <QVector>
+#include <memory>
+#include <functional>
+#include "task.h"
+#include "developer.h"
+
+// Компактный двоичный формат доски (*.sbb).
+//
+// Раскладка файла (все числа little-endian):
+//   заголовок (64 байта): сигнатура "SCRB", версия, число разработчиков,
+//                         задач, записей истории, смещения разделов
+//                         и номер последней записи журнала (BoardJournal)
+//   разработчики:  id, имя, должность                          (12 байт)
+//   задачи:        id, название, описание, статус, исполнитель,
+//                  дедлайн (мс), первая запись истории, их число (48 байт)
+//   история:       время (мс), значение, код действия, две строки (32 байта,
+//                  см. TaskHistoryEntry; в версии 1 - время, действие, подробности, 16 байт)
+//   строки:        число строк, таблица (смещение, длина), UTF-8 данные
+// Строки хранятся один раз в таблице, записи ссылаются на них по номеру.
+//
+// Файл открывается через mmap, а записи разбираются только при обращении.
+// open() проверяет лишь заголовок и границы разделов, поэтому не зависит от размера
+// доски; ссылки внутри записей проверяются при чтении (у повреждённой записи - пустая
+// строка или история). Строки декодируются из файла при каждом чтении, без кэша и
+// блокировок, так что читать файл можно из нескольких потоков. Если файлом владеет shared_ptr,
+// задачи могут ссылаться на него как на источник истории (HistoryMode::Lazy).
+class BinaryBoardFile : public HistorySource, public std::enable_shared_from_this<BinaryBoardFile> {
+public:
+    enum class HistoryMode {
+        Skip, // Задача без истории
+        Load, // История читается в память сразу
+        Lazy  // История остаётся в файле и читается по требованию
+    };
+
+    static const char* extension; // Расширение файла без точки
+    static bool isBinaryFileName(const QString& filename);
+
+    // Записать доску атомарно (через QSaveFile)
+    // journalSequence - номер последнего изменения из журнала доски, вошедшего в снимок
+    // progress(записано задач, всего задач) вызывается в потоке записи
+    static bool write(const QString& filename, const QList<Developer>& developers, const QList<Task>& tasks,
+                      quint64 journalSequence = 0,
+                      const std::function<void(int, int)>& progress = std::function<void(int, int)>());
+
+    explicit BinaryBoardFile(const QString& filename);
+
+    bool open(); // Отобразить файл в память и проверить заголовок
+    QString errorString() const { return errorText; }
+    qint64 fileSize() const { return size; }
+    quint64 journalSequence() const { return sequence; }
+
+    int developerCount() const { return int(developerTotal); }
+    int taskCount() const { return int(taskTotal); }
+    Developer developer(int index) const;
+    QString fileName() const { return file.fileName(); }
+    Task task(int index, HistoryMode mode = HistoryMode::Load) const;
+    QList<TaskHistoryEntry> history(int taskIndex) const;
+    QString string(quint32 index) const; // Строка из таблицы (декодируется при каждом вызове)
+
+    // HistorySource: key - номер задачи в файле. Можно вызывать из разных потоков
+    TaskHistoryEntry historyEntry(int key, int index) const override;
+    QList<TaskHistoryEntry> historyEntries(int key) const override { return history(key); }
+
+private:
+    QFile file;
+    const uchar* data = nullptr;
+    qint64 size = 0;
+    quint32 developerTotal = 0;
+    quint32 taskTotal = 0;
+    quint32 historyTotal = 0;
+    quint32 stringTotal = 0;
+    quint64 developersOffset = 0;
+    quint64 tasksOffset = 0;
+    quint64 historyOffset = 0;
+    quint64 stringIndexOffset = 0;
+    quint64 sequence = 0;
+    quint32 version = 0;
+    QString errorText;
+
+    bool fail(const QString& text);
+    const uchar* taskRecord(int index) const;
+    quint32 historyCount(const uchar* record) const; // 0, если диапазон истории повреждён
+    bool stringFits(quint32 index) const;           // Строка лежит внутри файла
+    TaskHistoryEntry decodeHistory(quint64 record) const;
+};
+
+#endif // BINARYBOARDFILE_H
@@ -1,167 +1,1158 @@
 #include "board.h"
 #include <QFile> // Для работы с файлами
-#include <QJsonArray> // Для работы с JSON массивами
-#include <QJsonDocument> // Для работы с JSON документами
+#include <QSaveFile> // Атомарная запись файла
+#include <QFileInfo>
+#include <QSemaphore>
+#include <QThreadPool>
+#include <algorithm>
+#include <deque>
+#include "binaryboardfile.h"
+#include "jsonstreamreader.h"
+#include "jsonstreamwriter.h"
+#include "trace.h"
+
+// Как часто сообщать о ходе загрузки (в прочитанных байтах)
+static const qint64 progressStep = 1024 * 1024;
+
+// Сколько задач разбирает один поток за раз при загрузке JSON
+static const int parseChunkSize = 512;
+
+namespace {
+
+// Порция задач для разбора в пуле потоков: сырой текст элементов массива "tasks"
+// на входе, готовые задачи на выходе. done освобождается, когда порция разобрана
+struct TaskChunk {
+    QVector<QByteArray> raw;
+    QList<Task> tasks;
+    bool failed = false;
+    QSemaphore done;
+};
+
+void parseChunk(TaskChunk& chunk) {
+    TRACE_SCOPE("Board::parseChunk");
+    chunk.tasks.reserve(chunk.raw.size());
+    for (const QByteArray& text : chunk.raw) {
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(text, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            chunk.failed = true;
+            break;
+        }
+        chunk.tasks.append(Task::parseJson(doc.object()));
+    }
+    chunk.raw.clear(); // Текст больше не нужен - не держим его до сборки результата
+}
+
+// Переставить добавленные пакетом элементы на запомненные места (positions: ID -> позиция
+// в списке до пакета), сохранив порядок остальных. Один проход по списку; номера в slots
+// пересчитываются от первой затронутой позиции. Возвращает пары (позиция, ID) по возрастанию
+template <typename List, typename GetId>
+QList<QPair<int, int>> placeItems(List& items, QHash<int, int>& slots,
+                                  const QHash<int, int>& positions, GetId getId) {
+    QList<QPair<int, int>> placed;
+    int from = items.size();
+    for (auto it = positions.constBegin(); it != positions.constEnd(); ++it) {
+        auto slot = slots.constFind(it.key());
+        if (slot != slots.constEnd()) { // Элемент могли удалить дальше в том же пакете
+            placed.append({it.value(), it.key()});
+            from = qMin(from, qMin(it.value(), slot.value()));
+        }
+    }
+    if (placed.isEmpty()) {
+        return placed;
+    }
+    std::sort(placed.begin(), placed.end());
+
+    QSet<int> moving;
+    for (const auto& entry : placed) {
+        moving.insert(entry.second);
+    }
+    List result;
+    result.reserve(items.size());
+    int next = 0;
+    for (const auto& item : items) {
+        if (moving.contains(getId(item))) {
+            continue;
+        }
+        for (; next < placed.size() && placed[next].first <= result.size(); next++) {
+            result.append(items[slots.value(placed[next].second)]);
+        }
+        result.append(item);
+    }
+    for (; next < placed.size(); next++) {
+        result.append(items[slots.value(placed[next].second)]);
+    }
+    items = std::move(result);
+    for (int i = from; i < items.size(); i++) {
+        slots[getId(items[i])] = i;
+    }
+    return placed;
+}
+
+} // namespace
  
 Board::Board() {
+    resetStats();
+}
+
+Board::~Board() {
+    for (Task* task : tasks) {
+        taskArena.destroy(task);
+    }
 }
 
 void Board::addDeveloper(const Developer& developer) {  // developer передается по константной ссылке для избежания копирования
+    auto it = developerSlots.constFind(developer.getId());
+    if (it != developerSlots.constEnd()) {
+        if (undoStack.isRecording()) {
+            undoStack.record(BoardOperation::addDeveloper(developer),
+                             BoardOperation::addDeveloper(developers[it.value()]),
+                             QString("Изменение разработчика «%1»").arg(developer.getName()));
+        }
+        developers[it.value()] = developer; // ID уже есть - заменяем запись, чтобы индекс оставался однозначным
+        revision++;
+        if (journal) journal->recordDeveloper(nextSequence(), developer);
+        // Карточки задач показывают данные разработчика
+        for (int taskId : developerIndex.value(developer.getId())) {
+            markChanged(taskId);
+        }
+        return;
+    }
+    if (undoStack.isRecording()) {
+        undoStack.record(BoardOperation::addDeveloper(developer), BoardOperation::removeDeveloper(developer.getId()),
+                         QString("Добавление разработчика «%1»").arg(developer.getName()));
+    }
+    developerIds.reserve(developer.getId());
+    developerSlots.insert(developer.getId(), developers.size());
     developers.append(developer); // Добавляем копию разработчика в список
+    revision++;
+    if (journal) journal->recordDeveloper(nextSequence(), developer);
 }
 
 bool Board::removeDeveloper(int developerId) {
-    for (int i = 0; i < developers.size(); i++) {
-        if (developers[i].getId() == developerId) {
-            // Снимаем назначение со всех задач этого разработчика
-            for (Task& task : tasks) {
-                if (task.getAssignedDeveloperId() == developerId) {
-                    task.unassign();  // Снимаем назначение с задачи
-                }
+    const Developer* developer = getDeveloper(developerId);
+    if (!developer) {
+        return false; // Разработчик с таким ID не найден
+    }
+    // Снятие назначений и удаление - один пакет и один шаг отмены
+    beginUndoStep(QString("Удаление разработчика «%1»").arg(developer->getName()));
+    bool removed = applyBatch({BoardOperation::removeDeveloper(developerId)});
+    endUndoStep();
+    return removed;
+}
+
+void Board::eraseDeveloper(int developerId) {
+    // Как и у задач: позиция остаётся пустой до compactDevelopers(), порядок остальных не меняется
+    auto it = developerSlots.find(developerId);
+    int slot = it.value();
+    developerSlots.erase(it);
+    if (firstDeveloperHole < 0 || slot < firstDeveloperHole) {
+        firstDeveloperHole = slot;
+    }
+    revision++;
+    if (journal) journal->recordDeveloperRemoved(nextSequence(), developerId);
+}
+
+// Позиция занята, если developerSlots указывает на неё; остальные - места удалённых
+void Board::compactDevelopers() {
+    if (firstDeveloperHole < 0) {
+        return;
+    }
+    int kept = firstDeveloperHole;
+    for (int i = firstDeveloperHole; i < developers.size(); i++) {
+        auto it = developerSlots.find(developers[i].getId());
+        if (it != developerSlots.end() && it.value() == i) {
+            if (kept != i) {
+                developers[kept] = std::move(developers[i]);
             }
-            developers.removeAt(i);
-            return true;
+            it.value() = kept;
+            kept++;
         }
     }
-    return false; // Разработчик с таким ID не найден
+    developers.erase(developers.begin() + kept, developers.end());
+    firstDeveloperHole = -1;
 }
 
 // Получение разработчика по ID
 Developer* Board::getDeveloper(int developerId) {
-    for (Developer& dev : developers) {
-        if (dev.getId() == developerId) {
-            return &dev;
-        }
+    int slot = developerSlots.value(developerId, -1);
+    if (slot < 0) {
+        return nullptr; // Если не нашли - возвращаем нулевой указатель
     }
-    return nullptr; // Если не нашли - возвращаем нулевой указатель
+    return &developers[slot];
 }
 
 void Board::addTask(const Task& task) {
-    tasks.append(task);
+    auto it = taskSlots.constFind(task.getId());
+    if (it != taskSlots.constEnd()) {
+        Task& stored = *tasks[it.value()]; // ID уже есть - заменяем задачу на том же месте
+        if (undoStack.isRecording()) {
+            undoStack.record(BoardOperation::addTask(task), BoardOperation::addTask(stored),
+                             QString("Изменение задачи «%1»").arg(task.getTitle()));
+        }
+        unindexTask(stored);
+        stored = task; // Присваивание не переносит наблюдателя - подписка остаётся на доске
+        stored.setObserver(this);
+        indexTask(stored);
+        markChanged(task.getId());
+        if (journal) journal->recordTask(nextSequence(), stored);
+        return;
+    }
+    if (undoStack.isRecording()) {
+        undoStack.record(BoardOperation::addTask(task), BoardOperation::removeTask(task.getId()),
+                         QString("Добавление задачи «%1»").arg(task.getTitle()));
+    }
+    taskIds.reserve(task.getId());
+    Task* stored = taskArena.create(task);
+    stored->setObserver(this); // Подписываемся на изменения своей копии
+    taskSlots.insert(task.getId(), tasks.size());
+    tasks.append(stored);
+    indexTask(*stored);
+    markChanged(task.getId());
+    if (journal) journal->recordTask(nextSequence(), *stored);
+}
+
+Task* Board::createTask(const QString& title, const QString& description) {
+    Task task(taskIds.allocate(), title, description);
+    addTask(task);
+    return getTask(task.id);
+}
+
+Developer* Board::createDeveloper(const QString& name, const QString& position) {
+    Developer developer(developerIds.allocate(), name, position);
+    addDeveloper(developer);
+    return getDeveloper(developer.id);
 }
 
 bool Board::removeTask(int taskId) {
-    for (int i = 0; i < tasks.size(); i++) {
-        if (tasks[i].getId() == taskId) {
-            tasks.removeAt(i);
-            return true;
+    Task* task = getTask(taskId);
+    if (!task) {
+        return false;
+    }
+    if (undoStack.isRecording()) {
+        // Копия разделяет строки и историю с удаляемой задачей
+        undoStack.record(BoardOperation::removeTask(taskId), BoardOperation::addTask(*task, taskSlots.value(taskId)),
+                         QString("Удаление задачи «%1»").arg(task->getTitle()));
+    }
+    unindexTask(*task);
+    eraseTask(taskId);
+    compactTasks();
+    markRemoved(taskId);
+    if (journal) journal->recordTaskRemoved(nextSequence(), taskId);
+    return true;
+}
+
+void Board::eraseTask(int taskId) {
+    auto it = taskSlots.find(taskId);
+    int slot = it.value();
+    taskSlots.erase(it);
+    taskArena.destroy(tasks[slot]);
+    // Позиция остаётся пустой до compactTasks(): так пакет удалений сдвигает массив один раз
+    tasks[slot] = nullptr;
+    if (firstHole < 0 || slot < firstHole) {
+        firstHole = slot;
+    }
+}
+
+// Сдвигает указатели на места удалённых задач одним проходом от первой пустой позиции.
+// Порядок задач сохраняется; позиции пересчитываются только у задач после неё
+void Board::compactTasks() {
+    if (firstHole < 0) {
+        return;
+    }
+    int kept = firstHole;
+    for (int i = firstHole; i < tasks.size(); i++) {
+        if (tasks[i]) {
+            tasks[kept] = tasks[i];
+            taskSlots[tasks[kept]->getId()] = kept;
+            kept++;
         }
     }
-    return false;
+    tasks.resize(kept);
+    firstHole = -1;
 }
 
 Task* Board::getTask(int taskId) {
-    for (Task& task : tasks) {
-        if (task.getId() == taskId) {
-            return &task;
+    int slot = taskSlots.value(taskId, -1);
+    if (slot < 0) {
+        return nullptr;  // Задача не найдена
+    }
+    return tasks[slot];
+}
+
+bool Board::applyBatch(const QVector<BoardOperation>& operations, QString* errorText) {
+    TRACE_SCOPE("Board::applyBatch");
+    // Проверка всего пакета до первого изменения: так откатывать ничего не придётся.
+    // exists / developerExists - задачи и разработчики, добавленные (true) или удалённые (false)
+    // предыдущими операциями пакета
+    QHash<int, bool> exists;
+    QHash<int, bool> developerExists;
+    auto taskExists = [&](int taskId) {
+        auto it = exists.constFind(taskId);
+        return it != exists.constEnd() ? it.value() : hasTask(taskId);
+    };
+    auto hasDeveloper = [&](int developerId) {
+        auto it = developerExists.constFind(developerId);
+        return it != developerExists.constEnd() ? it.value() : developerSlots.contains(developerId);
+    };
+    for (int i = 0; i < operations.size(); i++) {
+        const BoardOperation& operation = operations[i];
+        QString problem;
+        if (operation.type == BoardOperation::AddTask) {
+            exists[operation.task->getId()] = true;
+        } else if (operation.type == BoardOperation::AddDeveloper) {
+            developerExists[operation.developer->getId()] = true;
+        } else if (operation.type == BoardOperation::RemoveDeveloper) {
+            if (!hasDeveloper(operation.developerId)) {
+                problem = QString("разработчик ID %1 не найден").arg(operation.developerId);
+            }
+            developerExists[operation.developerId] = false;
+        } else if (!taskExists(operation.taskId)) {
+            problem = QString("задача ID %1 не найдена").arg(operation.taskId);
+        } else if (operation.type == BoardOperation::RemoveTask) {
+            exists[operation.taskId] = false;
+        } else if (operation.type == BoardOperation::Assign && operation.developerId != -1
+                   && !hasDeveloper(operation.developerId)) {
+            problem = QString("разработчик ID %1 не найден").arg(operation.developerId);
+        }
+        if (!problem.isEmpty()) {
+            if (errorText) *errorText = QString("Операция %1: %2").arg(i + 1).arg(problem);
+            return false;
         }
     }
-    return nullptr;  // Задача не найдена
+
+    // Затронутая задача выводится из индексов при первом касании
+    // и возвращается в них один раз после всех операций
+    QSet<int> touched;
+    QSet<int> removed;
+    // Новые задачи и разработчики с запомненным местом (ID -> позиция): ставятся на него в конце пакета
+    QHash<int, int> taskPositions;
+    QHash<int, int> developerPositions;
+    auto touch = [&](int taskId) {
+        Task* task = getTask(taskId);
+        if (task && !touched.contains(taskId)) {
+            touched.insert(taskId);
+            unindexTask(*task);
+        }
+        return task;
+    };
+
+    // Весь пакет - один шаг отмены; обратная операция запоминается до применения прямой
+    const bool recording = undoStack.isRecording();
+    undoStack.beginStep("Пакетное изменение");
+    batching = true;
+    for (const BoardOperation& operation : operations) {
+        switch (operation.type) {
+        case BoardOperation::AddTask: {
+            const int taskId = operation.task->getId();
+            Task* stored = touch(taskId);
+            if (recording) {
+                undoStack.record(operation, stored ? BoardOperation::addTask(*stored) : BoardOperation::removeTask(taskId));
+            }
+            if (stored) {
+                *stored = *operation.task;
+            } else {
+                taskIds.reserve(taskId);
+                stored = taskArena.create(*operation.task);
+                taskSlots.insert(taskId, tasks.size());
+                tasks.append(stored);
+                touched.insert(taskId);
+                if (operation.position >= 0) {
+                    taskPositions.insert(taskId, operation.position);
+                }
+            }
+            stored->setObserver(this);
+            removed.remove(taskId);
+            break;
+        }
+        case BoardOperation::RemoveTask: {
+            Task* task = touch(operation.taskId);
+            if (recording) undoStack.record(operation, BoardOperation::addTask(*task, taskSlots.value(operation.taskId)));
+            eraseTask(operation.taskId);
+            touched.remove(operation.taskId);
+            removed.insert(operation.taskId);
+            break;
+        }
+        case BoardOperation::SetStatus: {
+            Task* task = touch(operation.taskId);
+            if (recording) undoStack.record(operation, BoardOperation::setStatus(operation.taskId, task->getStatus()));
+            task->setStatus(operation.status);
+            break;
+        }
+        case BoardOperation::Assign: {
+            Task* task = touch(operation.taskId);
+            if (recording) {
+                undoStack.record(operation, BoardOperation::assign(operation.taskId, task->getAssignedDeveloperId()));
+            }
+            if (operation.developerId == -1) {
+                task->unassign();
+            } else {
+                task->assignToDeveloper(operation.developerId);
+            }
+            break;
+        }
+        case BoardOperation::SetDeadline: {
+            Task* task = touch(operation.taskId);
+            if (recording) undoStack.record(operation, BoardOperation::setDeadline(operation.taskId, task->getDeadline()));
+            task->setDeadline(operation.deadline);
+            break;
+        }
+        case BoardOperation::SetTitle: {
+            Task* task = touch(operation.taskId);
+            if (recording) undoStack.record(operation, BoardOperation::setTitle(operation.taskId, task->getTitle()));
+            task->setTitle(operation.text);
+            break;
+        }
+        case BoardOperation::SetDescription: {
+            Task* task = touch(operation.taskId);
+            if (recording) {
+                undoStack.record(operation, BoardOperation::setDescription(operation.taskId, task->getDescription()));
+            }
+            task->setDescription(operation.text);
+            break;
+        }
+        case BoardOperation::AddDeveloper: {
+            const int developerId = operation.developer->getId();
+            if (operation.position >= 0 && !developerSlots.contains(developerId)) {
+                developerPositions.insert(developerId, operation.position);
+            }
+            addDeveloper(*operation.developer); // Сам пишет журнал и стек отмены
+            break;
+        }
+        case BoardOperation::RemoveDeveloper: {
+            // Задачи, уже выведенные пакетом из индексов, в developerIndex не видны
+            QList<int> assigned = developerIndex.value(operation.developerId).values();
+            for (int taskId : touched) {
+                if (getTask(taskId)->getAssignedDeveloperId() == operation.developerId) {
+                    assigned.append(taskId);
+                }
+            }
+            for (int taskId : assigned) {
+                if (recording) {
+                    undoStack.record(BoardOperation::assign(taskId, -1),
+                                     BoardOperation::assign(taskId, operation.developerId));
+                }
+                touch(taskId)->unassign();
+            }
+            if (recording) {
+                undoStack.record(operation, BoardOperation::addDeveloper(*getDeveloper(operation.developerId),
+                                                                         developerSlots.value(operation.developerId)));
+            }
+            eraseDeveloper(operation.developerId);
+            break;
+        }
+        }
+    }
+    batching = false;
+    compactTasks();
+    compactDevelopers();
+    const QList<QPair<int, int>> placedTasks =
+        placeItems(tasks, taskSlots, taskPositions, [](const Task* task) { return task->getId(); });
+    const QList<QPair<int, int>> placedDevelopers =
+        placeItems(developers, developerSlots, developerPositions, [](const Developer& dev) { return dev.getId(); });
+    undoStack.endStep();
+
+    // Удаления пишутся в журнал первыми: места возвращённых задач отсчитываются от итогового списка
+    for (int taskId : removed) {
+        markRemoved(taskId);
+        if (journal) journal->recordTaskRemoved(nextSequence(), taskId);
+    }
+    // Журнал получает итоговое состояние задачи одной записью вместо записи на каждое поле
+    for (int taskId : touched) {
+        const Task& task = *getTask(taskId);
+        indexTask(task);
+        markChanged(taskId);
+        if (journal && !taskPositions.contains(taskId)) journal->recordTask(nextSequence(), task);
+    }
+    // Задачи и разработчики, вставленные на место, - по возрастанию позиции
+    if (journal) {
+        for (const auto& entry : placedTasks) {
+            const int slot = taskSlots.value(entry.second);
+            journal->recordTask(nextSequence(), *tasks[slot], slot);
+        }
+        for (const auto& entry : placedDevelopers) {
+            const int slot = developerSlots.value(entry.second);
+            journal->recordDeveloper(nextSequence(), developers[slot], slot);
+        }
+    }
+    return true;
+}
+
+bool Board::undo() {
+    if (!undoStack.canUndo()) {
+        return false;
+    }
+    UndoStep step = undoStack.takeUndo();
+    QVector<BoardOperation> operations(step.undo.crbegin(), step.undo.crend());
+    undoStack.setSuspended(true);
+    bool applied = applyBatch(operations);
+    undoStack.setSuspended(false);
+    if (!applied) {
+        // Доска разошлась с записанными шагами - остальные шаги тоже применить нельзя
+        undoStack.clear();
+        return false;
+    }
+    undoStack.pushRedo(std::move(step));
+    return true;
+}
+
+bool Board::redo() {
+    if (!undoStack.canRedo()) {
+        return false;
+    }
+    UndoStep step = undoStack.takeRedo();
+    undoStack.setSuspended(true);
+    bool applied = applyBatch(step.redo);
+    undoStack.setSuspended(false);
+    if (!applied) {
+        undoStack.clear();
+        return false;
+    }
+    undoStack.pushUndo(std::move(step));
+    return true;
 }
 
 QList<Task*> Board::getTasksByStatus(TaskStatus status) {
+    return resolveTasks(statusIndex.value(status));
+}
+
+QList<Task*> Board::getTasksByDeveloper(int developerId) {
+    return resolveTasks(developerIndex.value(developerId));
+}
+
+QList<Task*> Board::resolveTasks(const QSet<int>& ids) {
     QList<Task*> result;  // Создаем список указателей на задачи
-    for (Task& task : tasks) {
-        if (task.getStatus() == status) {
-            result.append(&task); // Добавляем указатель на задачу в результат
+    result.reserve(ids.size());
+    for (int taskId : ids) {
+        result.append(tasks[taskSlots.value(taskId)]);
+    }
+    return result;
+}
+
+void Board::clear() {
+    developers.clear();
+    for (Task* task : tasks) {
+        taskArena.destroy(task);
+    }
+    tasks.clear();
+    taskArena.clear();
+    taskIds.reset();
+    developerIds.reset();
+    developerSlots.clear();
+    firstDeveloperHole = -1;
+    taskSlots.clear();
+    statusIndex.clear();
+    developerIndex.clear();
+    searchIndex.clear();
+    unindexedHistory.clear();
+    undoStack.clear();
+    resetStats();
+    pendingChanges = BoardChanges();
+    pendingChanges.reset = true;
+    historyFileName.clear();
+    closeJournal();
+    journalSequence = 0;
+    revision++;
+}
+
+BoardChanges Board::takeChanges() {
+    if (pendingChanges.reset) {
+        pendingChanges.changed.clear();
+        pendingChanges.removed.clear();
+    } else {
+        // Задачи, сменившие корзину срочности: карточкам нужно обновить подсветку
+        for (int taskId : urgencyChanged) {
+            if (taskSlots.contains(taskId)) {
+                pendingChanges.changed.insert(taskId);
+            }
         }
     }
-    return result;  // Возвращаем список
+    urgencyChanged.clear();
+    BoardChanges result = pendingChanges;
+    pendingChanges = BoardChanges();
+    return result;
 }
 
-QList<Task*> Board::getTasksByDeveloper(int developerId) {
-    QList<Task*> result;
-    for (Task& task : tasks) {         
-        // Проверяем, назначена ли задача данному разработчику
-        if (task.getAssignedDeveloperId() == developerId) {
-            result.append(&task);
+void Board::markChanged(int taskId) {
+    revision++;
+    if (!pendingChanges.reset) {
+        pendingChanges.changed.insert(taskId);
+    }
+}
+
+void Board::markRemoved(int taskId) {
+    revision++;
+    if (!pendingChanges.reset) {
+        pendingChanges.changed.remove(taskId);
+        pendingChanges.removed.insert(taskId);
+    }
+}
+
+void Board::indexTask(const Task& task) {
+    statusIndex[task.getStatus()].insert(task.getId());
+    developerIndex[task.getAssignedDeveloperId()].insert(task.getId());
+    accountTask(task.getId(), task.getStatus(), task.getAssignedDeveloperId(), task.getDeadline(), +1);
+    searchIndex.setText(task.getId(), task.searchableText());
+    if (task.getHistory().isLazy()) {
+        unindexedHistory.insert(task.getId()); // История из файла - до indexHistory() не читаем
+    } else {
+        searchIndex.addHistory(task.getId(), task.historyText());
+    }
+}
+
+void Board::unindexTask(const Task& task) {
+    statusIndex[task.getStatus()].remove(task.getId());
+    developerIndex[task.getAssignedDeveloperId()].remove(task.getId());
+    accountTask(task.getId(), task.getStatus(), task.getAssignedDeveloperId(), task.getDeadline(), -1);
+    searchIndex.remove(task.getId());
+    if (!unindexedHistory.remove(task.getId())) {
+        searchIndex.removeHistory(task.getId(), task.historyText()); // Читается история одной задачи
+    }
+}
+
+int Board::indexHistory() {
+    TRACE_SCOPE("Board::indexHistory");
+    const int count = unindexedHistory.size();
+    for (int taskId : unindexedHistory) {
+        searchIndex.addHistory(taskId, tasks[taskSlots.value(taskId)]->historyText());
+    }
+    unindexedHistory.clear();
+    return count;
+}
+
+QSet<int> Board::searchTasks(const QString& query) const {
+    QSet<int> candidates;
+    QSet<int> result = searchIndex.search(query, {}, &candidates);
+    return result.unite(matchHistory(candidates, query));
+}
+
+bool Board::taskMatchesSearch(int taskId, const QString& query) const {
+    if (searchIndex.matches(taskId, query)) {
+        return true;
+    }
+    auto it = taskSlots.constFind(taskId);
+    return it != taskSlots.constEnd() && searchIndex.mayMatchHistory(taskId, query)
+        && historyContains(*tasks[it.value()], query.toCaseFolded());
+}
+
+QSet<int> Board::matchHistory(const QSet<int>& candidates, const QString& query) const {
+    const QString folded = query.toCaseFolded();
+    QSet<int> result;
+    for (int taskId : candidates) {
+        auto it = taskSlots.constFind(taskId);
+        if (it != taskSlots.constEnd() && historyContains(*tasks[it.value()], folded)) {
+            result.insert(taskId);
         }
     }
     return result;
 }
 
-bool Board::hasUnassignedTasks() const {
-    for (const Task& task : tasks) {
-                // Проверяем два условия:
-        // 1. Задача не назначена (isAssigned() возвращает false)
-        // 2. Задача НЕ находится в бэклоге
-        // (логика: задачи в бэклоге еще не готовы к назначению)
-        if (!task.isAssigned() && task.getStatus() != TaskStatus::Backlog) {
-            return true; // Нашли неназначенную задачу
+bool Board::historyContains(const Task& task, const QString& folded) const {
+    return task.historyText().toCaseFolded().contains(folded);
+}
+
+// Учитывает (delta = +1) или вычитает (delta = -1) вклад задачи в статистику
+void Board::accountTask(int taskId, TaskStatus status, int developerId, const QDateTime& deadline, int delta) {
+    stats.total += delta;
+    stats.byStatus[static_cast<int>(status)] += delta;
+    if (developerId == -1 && status != TaskStatus::Backlog) {
+        stats.unassignedActive += delta;
+    }
+    accountDeadline(taskId, status, deadline, delta);
+}
+
+void Board::accountDeadline(int taskId, TaskStatus status, const QDateTime& deadline, int delta) {
+    if (deadline.isValid() && status != TaskStatus::Done) {
+        if (delta > 0) {
+            deadlineIndex.insert(deadline, taskId);
+        } else {
+            deadlineIndex.remove(deadline, taskId);
         }
     }
-    return false;  // Все задачи либо назначены, либо в бэклоге
+    countDeadline(BoardStats::deadlineBucket(status, deadline, statsTime), delta);
 }
 
-void Board::clear() {
-    developers.clear();
-    tasks.clear();
+void Board::countDeadline(DeadlineBucket bucket, int delta) {
+    switch (bucket) {
+    case DeadlineBucket::Overdue:
+        stats.overdue += delta;
+        break;
+    case DeadlineBucket::Today:
+        stats.dueToday += delta;
+        break;
+    case DeadlineBucket::Soon:
+        stats.dueSoon += delta;
+        break;
+    case DeadlineBucket::None:
+    case DeadlineBucket::Later:
+        break;
+    }
+}
+
+void Board::resetStats() {
+    stats = BoardStats();
+    statsTime = QDateTime::currentDateTime();
+    deadlineIndex.clear();
+    urgencyChanged.clear();
 }
 
-QJsonObject Board::toJson() const {
-    QJsonObject json; // Создаем пустой JSON объект
+// Сдвиг корзин дедлайнов от statsTime к now. Корзина зависит только от того, прошёл ли
+// дедлайн и сколько полуночей до него осталось, поэтому сменить её могли лишь задачи
+// с дедлайном в [statsTime, now) (стали просроченными), а если наступили новые сутки -
+// ещё задачи, чей дедлайн попал в новое «сегодня» или в новые «ближайшие 3 дня»
+int Board::advanceDeadlines(const QDateTime& now) {
+    const QDateTime old = statsTime;
+    QSet<int> candidates;
+    auto collect = [&](const QDateTime& from, const QDateTime& to) {
+        for (auto it = deadlineIndex.lowerBound(from); it != deadlineIndex.constEnd() && it.key() < to; ++it) {
+            candidates.insert(it.value());
+        }
+    };
+    if (now < old) {
+        // Часы перевели назад - проверяем все задачи с дедлайном
+        for (int taskId : deadlineIndex) {
+            candidates.insert(taskId);
+        }
+    } else {
+        collect(old, now);
+        if (now.date() != old.date()) {
+            collect(QDateTime(old.date().addDays(1), QTime(0, 0)), QDateTime(now.date().addDays(1), QTime(0, 0)));
+            collect(QDateTime(old.date().addDays(4), QTime(0, 0)), QDateTime(now.date().addDays(4), QTime(0, 0)));
+        }
+    }
+
+    int changedCount = 0;
+    for (int taskId : candidates) {
+        const Task* task = tasks[taskSlots.value(taskId)];
+        DeadlineBucket before = BoardStats::deadlineBucket(task->getStatus(), task->getDeadline(), old);
+        DeadlineBucket after = BoardStats::deadlineBucket(task->getStatus(), task->getDeadline(), now);
+        if (before != after) {
+            countDeadline(before, -1);
+            countDeadline(after, +1);
+            urgencyChanged.insert(taskId);
+            changedCount++;
+        }
+    }
+    statsTime = now;
+    return changedCount;
+}
 
-    // Сохраняем разработчиков
-    QJsonArray devsArray;
-    for (const Developer& dev : developers) {
-        devsArray.append(dev.toJson()); // Каждый разработчик должен иметь метод toJson()
+QDateTime Board::nextDeadlineTransition() const {
+    // Задачи с прошедшим дедлайном останутся просроченными
+    auto it = deadlineIndex.lowerBound(statsTime);
+    if (it == deadlineIndex.constEnd()) {
+        return QDateTime();
     }
-    json["developers"] = devsArray;  // Добавляем массив в JSON
+    // Задача просрочена, когда текущий момент позже дедлайна, то есть через 1 мс после него
+    QDateTime midnight(statsTime.date().addDays(1), QTime(0, 0));
+    return qMin(it.key().addMSecs(1), midnight);
+}
 
-    // Сохраняем задачи
-    QJsonArray tasksArray;
-    for (const Task& task : tasks) {
-        tasksArray.append(task.toJson());
+// Сдвигает корзины, только если какая-то задача уже должна была сменить корзину
+int Board::updateDeadlines() {
+    QDateTime now = QDateTime::currentDateTime();
+    QDateTime next = nextDeadlineTransition();
+    if (now < statsTime || (next.isValid() && now >= next)) {
+        return advanceDeadlines(now);
     }
-    json["tasks"] = tasksArray;
+    return 0;
+}
+
+DeadlineBucket Board::getDeadlineBucket(const Task& task) const {
+    return BoardStats::deadlineBucket(task.getStatus(), task.getDeadline(), statsTime);
+}
 
-    return json;
+bool Board::ownsTask(const Task& task) const {
+    int slot = taskSlots.value(task.getId(), -1);
+    return slot >= 0 && tasks[slot] == &task;
 }
 
-void Board::fromJson(const QJsonObject& json) {
-    clear();
+// Копии задач наблюдателя не получают, но setObserver(this) можно вызвать и для
+// чужой задачи - поэтому сначала проверяем, что изменился объект из списка доски.
+// Во время applyBatch() задачи выведены из индексов и вернутся в них в конце пакета
+void Board::taskStatusChanged(const Task& task, TaskStatus oldStatus) {
+    if (batching || !ownsTask(task)) return;
+    statusIndex[oldStatus].remove(task.getId());
+    statusIndex[task.getStatus()].insert(task.getId());
+    undoStack.record(BoardOperation::setStatus(task.getId(), task.getStatus()),
+                     BoardOperation::setStatus(task.getId(), oldStatus),
+                     QString("Смена статуса задачи «%1»").arg(task.getTitle()));
+    accountTask(task.getId(), oldStatus, task.getAssignedDeveloperId(), task.getDeadline(), -1);
+    accountTask(task.getId(), task.getStatus(), task.getAssignedDeveloperId(), task.getDeadline(), +1);
+    markChanged(task.getId());
+    if (journal) journal->recordField(nextSequence(), task.getId(), "status", Task::statusToString(task.getStatus()));
+}
 
-    // Загружаем разработчиков
-    QJsonArray devsArray = json["developers"].toArray();
-    for (const QJsonValue& value : devsArray) {         // Developer должен иметь статический метод fromJson
-        developers.append(Developer::fromJson(value.toObject()));
+void Board::taskTitleChanged(const Task& task, const QString& oldTitle) {
+    if (batching || !ownsTask(task)) return;
+    undoStack.record(BoardOperation::setTitle(task.getId(), task.getTitle()),
+                     BoardOperation::setTitle(task.getId(), oldTitle),
+                     QString("Переименование задачи «%1»").arg(oldTitle));
+    searchIndex.setText(task.getId(), task.searchableText());
+    markChanged(task.getId());
+    if (journal) journal->recordField(nextSequence(), task.getId(), "title", task.getTitle());
+}
+
+void Board::taskDescriptionChanged(const Task& task, const QString& oldDescription) {
+    if (batching || !ownsTask(task)) return;
+    undoStack.record(BoardOperation::setDescription(task.getId(), task.getDescription()),
+                     BoardOperation::setDescription(task.getId(), oldDescription),
+                     QString("Изменение описания задачи «%1»").arg(task.getTitle()));
+    searchIndex.setText(task.getId(), task.searchableText());
+    markChanged(task.getId());
+    if (journal) journal->recordField(nextSequence(), task.getId(), "description", task.getDescription());
+}
+
+void Board::taskHistoryAppended(const Task& task, const TaskHistoryEntry& entry) {
+    if (batching || !ownsTask(task)) return;
+    if (!unindexedHistory.contains(task.getId())) {
+        searchIndex.addHistory(task.getId(), entry.getDetails()); // История только растёт - дописываем
     }
+    revision++;
+    if (journal) journal->recordHistory(nextSequence(), task.getId(), entry);
+}
+
+void Board::taskAssigneeChanged(const Task& task, int oldDeveloperId) {
+    if (batching || !ownsTask(task)) return;
+    developerIndex[oldDeveloperId].remove(task.getId());
+    developerIndex[task.getAssignedDeveloperId()].insert(task.getId());
+    undoStack.record(BoardOperation::assign(task.getId(), task.getAssignedDeveloperId()),
+                     BoardOperation::assign(task.getId(), oldDeveloperId),
+                     QString("Назначение задачи «%1»").arg(task.getTitle()));
+    accountTask(task.getId(), task.getStatus(), oldDeveloperId, task.getDeadline(), -1);
+    accountTask(task.getId(), task.getStatus(), task.getAssignedDeveloperId(), task.getDeadline(), +1);
+    markChanged(task.getId());
+    if (journal) journal->recordField(nextSequence(), task.getId(), "assignee", task.getAssignedDeveloperId());
+}
 
-    // Загружаем задачи
-    QJsonArray tasksArray = json["tasks"].toArray();
-    for (const QJsonValue& value : tasksArray) {
-        tasks.append(Task::fromJson(value.toObject()));
+void Board::taskDeadlineChanged(const Task& task, const QDateTime& oldDeadline) {
+    if (batching || !ownsTask(task)) return;
+    undoStack.record(BoardOperation::setDeadline(task.getId(), task.getDeadline()),
+                     BoardOperation::setDeadline(task.getId(), oldDeadline),
+                     QString("Изменение дедлайна задачи «%1»").arg(task.getTitle()));
+    accountDeadline(task.getId(), task.getStatus(), oldDeadline, -1);
+    accountDeadline(task.getId(), task.getStatus(), task.getDeadline(), +1);
+    markChanged(task.getId());
+    if (journal) {
+        QString deadline = task.getDeadline().isValid() ? task.getDeadline().toString(Qt::ISODate) : QString();
+        journal->recordField(nextSequence(), task.getId(), "deadline", deadline);
     }
 }
 
 bool Board::saveToFile(const QString& filename) const {
-    QFile file(filename); // Создаем объект файла
-    // Открываем файл для записи
+    return saveSnapshot(snapshot(filename), filename);
+}
+
+BoardSnapshot Board::snapshot(const QString& targetFilename) const {
+    TRACE_SCOPE("Board::snapshot");
+    // История задач из *.sbb читается прямо из отображённого файла. QSaveFile подменяет
+    // файл переименованием: на POSIX отображение старого файла остаётся действительным,
+    // а Windows не даёт заменить отображённый файл - там историю переносим в память,
+    // и только если снимок пишется именно в этот файл
+#ifdef Q_OS_WIN
+    if (!historyFileName.isEmpty() && !targetFilename.isEmpty()
+        && QFileInfo(targetFilename).absoluteFilePath() == QFileInfo(historyFileName).absoluteFilePath()) {
+        for (const Task* task : tasks) {
+            task->getHistory().materialize();
+        }
+    }
+#else
+    Q_UNUSED(targetFilename);
+#endif
+
+    BoardSnapshot result;
+    result.developers = developers;
+    // Копия задачи разделяет с ней строки и историю
+    result.tasks.reserve(tasks.size());
+    for (const Task* task : tasks) {
+        result.tasks.append(*task); // Копия без наблюдателя - снимок не уведомляет доску
+    }
+    result.journalSequence = journalSequence;
+    result.revision = revision;
+    // Задачи скопированы в том же порядке, поэтому позиции в taskSlots совпадают
+    result.taskSlots = taskSlots;
+    result.statusIndex = statusIndex;
+    result.developerIndex = developerIndex;
+    return result;
+}
+
+// Задачи снимка по набору ID из его индекса
+static QList<const Task*> resolveSnapshotTasks(const BoardSnapshot& snapshot, const QSet<int>& ids) {
+    QList<const Task*> result;
+    result.reserve(ids.size());
+    for (int taskId : ids) {
+        result.append(&snapshot.tasks[snapshot.taskSlots.value(taskId)]);
+    }
+    return result;
+}
+
+const Task* BoardSnapshot::task(int taskId) const {
+    int slot = taskSlots.value(taskId, -1);
+    return slot < 0 ? nullptr : &tasks[slot];
+}
+
+QList<const Task*> BoardSnapshot::tasksByStatus(TaskStatus status) const {
+    return resolveSnapshotTasks(*this, statusIndex.value(status));
+}
+
+QList<const Task*> BoardSnapshot::tasksByDeveloper(int developerId) const {
+    return resolveSnapshotTasks(*this, developerIndex.value(developerId));
+}
+
+bool Board::saveSnapshot(const BoardSnapshot& snapshot, const QString& filename, const SaveProgress& progress) {
+    TRACE_SCOPE("Board::saveSnapshot");
+    if (BinaryBoardFile::isBinaryFileName(filename)) {
+        return BinaryBoardFile::write(filename, snapshot.developers, snapshot.tasks,
+                                      snapshot.journalSequence, progress);
+    }
+    return saveJson(snapshot, filename, progress);
+}
+
+bool Board::saveJson(const BoardSnapshot& snapshot, const QString& filename, const SaveProgress& progress) {
+    // QSaveFile пишет во временный файл рядом и подменяет им исходный только в commit(),
+    // поэтому сбой посреди записи не портит уже сохранённую доску
+    QSaveFile file(filename);
     if (!file.open(QIODevice::WriteOnly)) {
         return false;
     }
-    // Создаем JSON документ из нашего объекта
-    QJsonDocument doc(toJson());
-    file.write(doc.toJson());
-    file.close();
+
+    // Задачи пишутся в поток по одной, без построения QJsonDocument всей доски
+    JsonStreamWriter writer(&file);
+    writer.beginObject();
+    writer.key("developers");
+    writer.beginArray();
+    for (const Developer& dev : snapshot.developers) {
+        dev.writeJson(writer);
+    }
+    writer.endArray();
+
+    writer.key("tasks");
+    writer.beginArray();
+    const int total = snapshot.tasks.size();
+    const int progressStepTasks = qMax(1, total / 100);
+    for (int i = 0; i < total; i++) {
+        snapshot.tasks[i].writeJson(writer);
+        if (progress && (i + 1) % progressStepTasks == 0) {
+            progress(i + 1, total);
+        }
+    }
+    writer.endArray();
+
+    writer.key("journalSequence"); // Записи журнала до этого номера уже в снимке
+    writer.value(qint64(snapshot.journalSequence));
+    writer.endObject();
+
+    if (!writer.flush()) {
+        file.cancelWriting(); // Исходный файл остаётся нетронутым
+        return false;
+    }
+    return file.commit();
+}
+
+bool Board::loadFromFile(const QString& filename, const LoadProgress& progress) {
+    TRACE_SCOPE("Board::loadFromFile");
+    return loadSnapshot(filename, QString(), progress);
+}
+
+bool Board::recoverFromFile(const QString& snapshotFilename, const QString& journalBoardFilename) {
+    TRACE_SCOPE("Board::recoverFromFile");
+    return loadSnapshot(snapshotFilename, BoardJournal::journalFileName(journalBoardFilename), LoadProgress());
+}
+
+bool Board::loadSnapshot(const QString& filename, const QString& journalFilename, const LoadProgress& progress) {
+    // Доска заменяется лишь после успешного чтения всего файла
+    BoardSnapshot loaded;
+    if (!filename.isEmpty()) {
+        bool ok = BinaryBoardFile::isBinaryFileName(filename)
+            ? readBinary(filename, progress, loaded)
+            : readJson(filename, progress, loaded);
+        if (!ok) {
+            return false;
+        }
+    }
+    // Изменения, сделанные после сохранения снимка
+    if (!journalFilename.isEmpty()) {
+        TRACE_SCOPE("BoardJournal::replay");
+        BoardJournal::replay(journalFilename, loaded.journalSequence, loaded.developers, loaded.tasks);
+    }
+
+    replaceContents(loaded);
+    if (BinaryBoardFile::isBinaryFileName(filename)) {
+        historyFileName = filename;
+    }
     return true;
 }
 
-bool Board::loadFromFile(const QString& filename) {
+bool Board::readJson(const QString& filename, const LoadProgress& progress, BoardSnapshot& loaded) {
+    TRACE_SCOPE("Board::readJson");
     QFile file(filename);
     if (!file.open(QIODevice::ReadOnly)) {
         return false;
     }
 
-    QByteArray data = file.readAll();     // Читаем все содержимое файла
-    file.close(); // Закрываем файл сразу после чтения
+    // Файл читается порциями, а в DOM разбирается только одна задача за раз.
+    // Читатель лишь нарезает массив задач на куски текста; разбор JSON, дат и истории
+    // идёт в пуле потоков. Куски собираются строго по очереди, так что порядок задач
+    // совпадает с файлом, а число кусков в работе ограничено (память не растёт)
+    const qint64 totalBytes = file.size();
+    qint64 reportedBytes = 0;
+
+    QThreadPool pool; // Свой пул: деструктор дождётся кусков даже при ошибке чтения
+    const int maxInFlight = qMax(2, pool.maxThreadCount() * 2);
+    std::deque<std::shared_ptr<TaskChunk>> inFlight;
+    bool parsed = true;
+    auto collect = [&]() {
+        std::shared_ptr<TaskChunk> chunk = inFlight.front();
+        inFlight.pop_front();
+        chunk->done.acquire();
+        parsed = parsed && !chunk->failed;
+        loaded.tasks.append(chunk->tasks);
+    };
+    auto submit = [&](const std::shared_ptr<TaskChunk>& chunk) {
+        pool.start([chunk]() {
+            parseChunk(*chunk);
+            chunk->done.release();
+        });
+        inFlight.push_back(chunk);
+        if (int(inFlight.size()) > maxInFlight) {
+            collect();
+        }
+    };
+
+    JsonStreamReader reader(&file);
+    if (!reader.enterObject()) {
+        return false; // Документ должен быть объектом
+    }
+
+    QString key;
+    while (reader.nextKey(key)) {
+        if (key == "developers") {
+            if (!reader.enterArray()) break;
+            while (reader.nextElement()) {
+                loaded.developers.append(Developer::parseJson(reader.readObject()));
+            }
+        } else if (key == "tasks") {
+            if (!reader.enterArray()) break;
+            auto chunk = std::make_shared<TaskChunk>();
+            while (reader.nextElement()) {
+                chunk->raw.append(reader.readRawValue());
+                if (chunk->raw.size() == parseChunkSize) {
+                    submit(chunk);
+                    chunk = std::make_shared<TaskChunk>();
+                }
+                if (progress && reader.bytesConsumed() - reportedBytes >= progressStep) {
+                    reportedBytes = reader.bytesConsumed();
+                    progress(reportedBytes, totalBytes);
+                }
+            }
+            if (!chunk->raw.isEmpty()) {
+                submit(chunk);
+            }
+        } else if (key == "journalSequence") {
+            loaded.journalSequence = quint64(reader.readRawValue().toULongLong());
+        } else {
+            reader.skipValue(); // Неизвестные поля пропускаем
+        }
+    }
+    while (!inFlight.empty()) {
+        collect();
+    }
+    if (!parsed || reader.hasError() || !reader.atEnd()) {
+        return false;
+    }
+    if (progress) {
+        progress(totalBytes, totalBytes);
+    }
+    return true;
+}
 
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    // Проверяем, что документ валиден и является объектом
-    if (doc.isNull() || !doc.isObject()) {
+bool Board::readBinary(const QString& filename, const LoadProgress& progress, BoardSnapshot& loaded) {
+    TRACE_SCOPE("Board::readBinary");
+    // Файлом владеет shared_ptr: задачи ссылаются на него, пока их история не прочитана
+    auto file = std::make_shared<BinaryBoardFile>(filename);
+    if (!file->open()) {
         return false;
     }
 
-    fromJson(doc.object());
+    // Записи фиксированной длины - ход загрузки считаем по числу задач
+    const int taskCount = file->taskCount();
+    const qint64 totalBytes = file->fileSize();
+    const int progressTasks = qMax(1, int(qint64(taskCount) * progressStep / qMax<qint64>(totalBytes, 1)));
+
+    loaded.journalSequence = file->journalSequence();
+    loaded.developers.reserve(file->developerCount());
+    for (int i = 0; i < file->developerCount(); i++) {
+        loaded.developers.append(file->developer(i));
+    }
+    loaded.tasks.reserve(taskCount);
+    for (int i = 0; i < taskCount; i++) {
+        loaded.tasks.append(file->task(i, BinaryBoardFile::HistoryMode::Lazy));
+        if (progress && (i + 1) % progressTasks == 0) {
+            progress(totalBytes * (i + 1) / taskCount, totalBytes);
+        }
+    }
+    if (progress) {
+        progress(totalBytes, totalBytes);
+    }
     return true;
-}
\ No newline at end of file
+}
+
+void Board::replaceContents(const BoardSnapshot& loaded) {
+    clear(); // Закрывает и журнал: загрузка не должна попадать в журнал другой доски
+    undoStack.setSuspended(true); // Загрузку отменять нечем - стек остаётся пустым
+    for (const Developer& dev : loaded.developers) {
+        addDeveloper(dev);
+    }
+    // Память под все задачи выделяется одним блоком
+    tasks.reserve(loaded.tasks.size());
+    taskArena.reserve(loaded.tasks.size());
+    for (const Task& task : loaded.tasks) {
+        addTask(task); // Копия разделяет строки и историю с загруженной задачей
+    }
+    undoStack.setSuspended(false);
+    journalSequence = loaded.journalSequence;
+}
+
+bool Board::convertFile(const QString& sourceFilename, const QString& targetFilename) {
+    Board board;
+    return board.loadFromFile(sourceFilename) && board.saveToFile(targetFilename);
+}
+
+bool Board::openJournal(const QString& boardFilename, bool truncate) {
+    closeJournal();
+    auto opened = std::make_unique<BoardJournal>(boardFilename);
+    if (!opened->open() || (truncate && !opened->truncate())) {
+        return false;
+    }
+    journal = std::move(opened);
+    journalBoardFile = boardFilename;
+    return true;
+}
+
+bool Board::syncJournal() {
+    return journal ? journal->sync() : true;
+}
+
+bool Board::compactJournal() {
+    if (!journal || !journal->sync()) {
+        return false;
+    }
+    // Снимок запоминает номер последнего изменения, поэтому сбой между сохранением
+    // и очисткой журнала не приведёт к повторному применению записей
+    if (!saveToFile(journalBoardFile)) {
+        return false;
+    }
+    return journal->truncate();
+}
+
+bool Board::discardJournal(quint64 snapshotSequence) {
+    if (!journal || journalSequence != snapshotSequence) {
+        return false; // После снимка были изменения - они есть только в журнале
+    }
+    return journal->sync() && journal->truncate();
+}
+
+void Board::closeJournal() {
+    journal.reset(); // Деструктор дописывает буфер
+    journalBoardFile.clear();
+}
@@ -2,51 +2,294 @@
 #define BOARD_H
 
 #include <QList>  // Qt контейнер для хранения списков объектов
+#include <QHash>  // Хеш-таблица для индексов ID → позиция
+#include <QMap>
+#include <QMultiMap>
+#include <QSet>
 #include <QString> // Qt строковый класс (Юникод, безопасный)
 #include <QJsonDocument>
+#include <functional>
 #include "task.h"
 #include "developer.h"
+#include "boardstats.h"
+#include "searchindex.h"
+#include "boardjournal.h"
+#include "taskarena.h"
+#include "boardoperation.h"
+#include "undostack.h"
+#include "boardquery.h"
+#include <memory>
 
-class Board {
+// Доска хранит задачи и разработчиков и поддерживает индексы ID → позиция,
+// поэтому поиск по ID выполняется за O(1). Удаление задачи сохраняет порядок остальных:
+// сдвигаются указатели после неё (пакет удалений в applyBatch() - одним проходом).
+// Задачи лежат в арене (TaskArena): указатель Task* остаётся действительным, пока
+// задачу не удалили с доски, и его можно отдавать карточкам интерфейса.
+// Разработчики хранятся в списке, и указатели Developer* становятся
+// недействительными после любого добавления или удаления - для них храните ID.
+//
+// Кроме того, доска ведёт вторичные индексы «статус → задачи» и «разработчик → задачи».
+// Они обновляются по уведомлениям TaskObserver, которые задачи доски отправляют
+// из setStatus()/assignToDeveloper()/unassign()/setDeadline(). По тем же уведомлениям
+// обновляются счётчики BoardStats и журнал изменений для интерфейса (takeChanges()).
+//
+//
+// Потоки. Доска принадлежит одному потоку (в приложении - потоку интерфейса): менять её
+// и пользоваться указателями Task*/Developer* можно только там. Фоновые задачи получают
+// снимок snapshot() или копию индекса поиска getSearchIndex(): данные разделяются
+// неявно (copy-on-write), и правки доски после снимка его не меняют. Один снимок можно
+// читать из любого числа потоков одновременно, без блокировок.
+// ID выдаются атомарными счётчиками (IdAllocator), так что задачи и разработчиков можно
+// создавать в любом потоке. createTask()/createDeveloper() берут ID из счётчика самой доски;
+// добавление и загрузка задач сдвигают только его, а не общий счётчик конструкторов Task.
+//
+// Изменения задач, накопленные с последнего вызова Board::takeChanges()
+struct BoardChanges {
+    bool reset = false; // Доска перестроена целиком
+    QSet<int> changed;  // Добавленные или изменённые задачи
+    QSet<int> removed;  // Удалённые задачи
+
+    bool isEmpty() const { return !reset && changed.isEmpty() && removed.isEmpty(); }
+};
+
+// Копия содержимого доски, которую можно сохранять в фоновом потоке.
+// Строки и история задач разделяются с доской неявно (copy-on-write),
+// поэтому снимок дешёв, а последующие правки доски его не меняют
+struct BoardSnapshot {
+    QList<Developer> developers;
+    QList<Task> tasks;
+    quint64 journalSequence = 0; // Номер последнего изменения журнала, вошедшего в снимок
+    quint64 revision = 0;        // Board::getRevision() в момент снимка
+
+    // Индексы доски на момент снимка: ID → позиция в tasks, статус → ID,
+    // разработчик → ID. Заполняет только Board::snapshot(); у снимков,
+    // прочитанных из файла, они пусты и запросы ниже возвращают пустой результат
+    QHash<int, int> taskSlots;
+    QMap<TaskStatus, QSet<int>> statusIndex;
+    QHash<int, QSet<int>> developerIndex;
+
+    const Task* task(int taskId) const;
+    QList<const Task*> tasksByStatus(TaskStatus status) const;
+    QList<const Task*> tasksByDeveloper(int developerId) const;
+};
+
+class Board : private TaskObserver {
 public:
     Board();
+    // Задачи доски ссылаются на неё как на наблюдателя, поэтому доску не копируем
+    Board(const Board&) = delete;
+    Board& operator=(const Board&) = delete;
+    ~Board();
 
     // Управление разработчиками
-    void addDeveloper(const Developer& developer);
+    void addDeveloper(const Developer& developer); // Разработчик с уже существующим ID заменяет старого
+    Developer* createDeveloper(const QString& name, const QString& position = "");
     bool removeDeveloper(int developerId);
     Developer* getDeveloper(int developerId); // Получение разработчика по ID
-    QList<Developer>& getDevelopers() { return developers; } // Возвращает ссылку на список (позволяет модифицировать)
-    const QList<Developer>& getDevelopers() const { return developers; } // Возвращает константную ссылку (только для чтения)
+    // Только для чтения: список меняется через addDeveloper()/removeDeveloper(), иначе разойдутся индексы
+    const QList<Developer>& getDevelopers() const { return developers; }
 
     // Управление задачами
-    void addTask(const Task& task);
+    void addTask(const Task& task); // Задача с уже существующим ID заменяет старую
+    // Новая задача с ID из счётчика этой доски (продолжает наибольший ID на доске)
+    Task* createTask(const QString& title, const QString& description = "");
+    // ID из счётчика доски для задачи, которая будет добавлена позже (например, пакетом)
+    int allocateTaskId() { return taskIds.allocate(); }
     bool removeTask(int taskId);
     Task* getTask(int taskId);
-    QList<Task>& getTasks() { return tasks; }
-    const QList<Task>& getTasks() const { return tasks; }
+    bool hasTask(int taskId) const { return taskSlots.contains(taskId); }
+    // Список задач в порядке добавления (удаление порядок остальных не меняет)
+    TaskRange<Task> getTasks() { return TaskRange<Task>(tasks); }
+    TaskRange<const Task> getTasks() const { return TaskRange<const Task>(tasks); }
 
-    // Получение задач по статусу
+    // Получение задач по статусу (порядок не определён), O(размер результата)
     QList<Task*> getTasksByStatus(TaskStatus status);
+    int countTasksByStatus(TaskStatus status) const { return statusIndex.value(status).size(); }
 
-    // Получение задач разработчика
+    // Получение задач разработчика (-1 - неназначенные задачи)
     QList<Task*> getTasksByDeveloper(int developerId);
+    int countTasksByDeveloper(int developerId) const { return developerIndex.value(developerId).size(); }
+
+    // Пакетное изменение: операции применяются по порядку, но индексы, статистика,
+    // поиск и журнал обновляются один раз на задачу в конце пакета, а takeChanges()
+    // сообщает о каждой задаче один раз. Пакет сначала проверяется целиком: если хоть
+    // одна операция невыполнима (нет задачи или разработчика), доска не меняется,
+    // возвращается false, а в errorText - описание ошибки
+    bool applyBatch(const QVector<BoardOperation>& operations, QString* errorText = nullptr);
+
+    // Отмена и повтор. Каждое изменение доски (и методами Board, и сеттерами Task*)
+    // записывается в стек отмены вместе с обратной операцией; beginUndoStep()/endUndoStep()
+    // объединяют несколько изменений (например, правку задачи в диалоге) в один шаг.
+    // undo()/redo() применяют операции шага одним пакетом applyBatch(), поэтому время
+    // зависит от размера шага, а не доски. История задач не откатывается: отмена
+    // дописывает в неё новые записи. Загрузка файла и clear() очищают стек
+    void beginUndoStep(const QString& text) { undoStack.beginStep(text); }
+    void endUndoStep() { undoStack.endStep(); }
+    bool undo();
+    bool redo();
+    const UndoStack& getUndoStack() const { return undoStack; }
+    void setUndoLimits(int maxSteps, int maxOperations) { undoStack.setLimits(maxSteps, maxOperations); }
 
     // Проверка: есть ли у задачи назначенный разработчик
-    bool hasUnassignedTasks() const;
+    bool hasUnassignedTasks() const { return stats.unassignedActive > 0; }
+
+    // Статистика доски (только чтение). Корзины дедлайнов разложены относительно момента
+    // последнего updateDeadlines(); часы здесь не читаются
+    const BoardStats& getStats() const { return stats; }
+
+    // Срочность задачи относительно момента последнего сдвига корзин (часы не читаются)
+    DeadlineBucket getDeadlineBucket(const Task& task) const;
+    // Когда ближайшая задача сменит корзину срочности: сразу после сегодняшнего дедлайна
+    // или в полночь. Невалидная дата - все дедлайны уже прошли, ждать нечего
+    QDateTime nextDeadlineTransition() const;
+    // Сдвинуть корзины к текущему моменту, если какая-то задача уже должна была сменить
+    // корзину (наступил nextDeadlineTransition()); пересчитываются только такие задачи.
+    // Сменившие корзину задачи попадают в takeChanges() (без увеличения getRevision() -
+    // содержимое доски не менялось); возвращает их число. Вызывается владельцем доски
+    // (по таймеру, перед запросом), поэтому константные методы доску не меняют
+    int updateDeadlines();
 
-    // Сохранение и загрузка
+    // Полнотекстовый поиск по названию, описанию и истории (без учёта регистра).
+    // Текст истории не хранится в индексе: задачи, подошедшие по её триграммам,
+    // проверяются чтением истории. Запросы короче трёх символов историю не смотрят
+    QSet<int> searchTasks(const QString& query) const;
+    bool taskMatchesSearch(int taskId, const QString& query) const;
+    // Индекс только для чтения; его копия - снимок для поиска в фоновом потоке.
+    // Кандидатов по истории из такого поиска проверяет matchHistory() в потоке доски
+    const SearchIndex& getSearchIndex() const { return searchIndex; }
+    QSet<int> matchHistory(const QSet<int>& candidates, const QString& query) const;
+    // История, загруженная из *.sbb, при загрузке не читается и в поиск не попадает,
+    // пока владелец доски не вызовет indexHistory() (перед первым поиском).
+    // Возвращает число проиндексированных задач
+    int indexHistory();
+
+    // Запрос по статусу, разработчику, дедлайнам, тексту и истории (язык - см. BoardQuery).
+    // Где можно, используются индексы доски; result.plan объясняет выбранный путь
+    QueryResult query(const BoardQuery& query) const { return query.run(*this); }
+
+    // Забрать накопленные изменения (журнал при этом очищается)
+    BoardChanges takeChanges();
+
+    // Сохранение и загрузка. Формат выбирается по расширению:
+    // *.sbb - двоичный (BinaryBoardFile), остальные - JSON
+    // Ход загрузки: сколько байт файла прочитано из общего размера
+    using LoadProgress = std::function<void(qint64 bytesRead, qint64 totalBytes)>;
     bool saveToFile(const QString& filename) const;
-    bool loadFromFile(const QString& filename);
+    bool loadFromFile(const QString& filename, const LoadProgress& progress = LoadProgress());
+    // Восстановление после сбоя: снимок snapshotFilename (пустое имя - пустая доска)
+    // и поверх него журнал доски journalBoardFilename (см. openJournal()).
+    // loadFromFile() журналы не читает: файл пользователя открывается как есть
+    bool recoverFromFile(const QString& snapshotFilename, const QString& journalBoardFilename);
+
+    // Снимок для фонового сохранения. targetFilename - куда он будет записан
+    // (нужно, чтобы не перезаписывать файл, из которого ещё читается история)
+    BoardSnapshot snapshot(const QString& targetFilename = QString()) const;
+    // Записать снимок в файл. Не обращается к доске - можно вызывать из любого потока
+    using SaveProgress = std::function<void(int tasksWritten, int totalTasks)>;
+    static bool saveSnapshot(const BoardSnapshot& snapshot, const QString& filename,
+                             const SaveProgress& progress = SaveProgress());
+    // Номер версии содержимого: растёт при любом изменении доски
+    quint64 getRevision() const { return revision; }
+
+    // Перевести файл доски из одного формата в другой (по расширениям имён)
+    static bool convertFile(const QString& sourceFilename, const QString& targetFilename);
+
+    // Журнал изменений на диске (см. BoardJournal). После openJournal() каждое изменение
+    // доски дописывается в "<файл>.journal", а recoverFromFile() проигрывает его поверх снимка.
+    // truncate: начать с пустого журнала (файл доски только что сохранён целиком)
+    bool openJournal(const QString& boardFilename, bool truncate = false);
+    bool syncJournal();    // Записать накопленные изменения с одним fsync
+    bool compactJournal(); // Сохранить снимок в файл доски и очистить журнал
+    // Очистить журнал после фонового сохранения снимка в файл доски,
+    // если после снимка (с этим номером журнала) ничего не изменилось
+    bool discardJournal(quint64 snapshotSequence);
+    void closeJournal();
+    bool hasJournal() const { return journal != nullptr; }
+    QString getJournalBoardFile() const { return journalBoardFile; }
+    qint64 getJournalSize() const { return journal ? journal->size() : 0; }
 
     // Очистка доски
     void clear();
 
 private:
+    friend class BoardQuery; // Планировщик запросов читает индексы доски напрямую
+
     QList<Developer> developers; // Список всех разработчиков
-    QList<Task> tasks;
+    TaskArena taskArena;         // Память под задачи
+    QVector<Task*> tasks;        // Все задачи доски (объекты в taskArena)
+
+    // Счётчики ID этой доски: всегда больше любого ID, добавленного на доску
+    IdAllocator taskIds;
+    IdAllocator developerIds;
+
+    // Индексы: ID → позиция в соответствующем списке
+    QHash<int, int> developerSlots;
+    QHash<int, int> taskSlots;
+
+    // Вторичные индексы: статус → ID задач, ID разработчика → ID задач
+    QMap<TaskStatus, QSet<int>> statusIndex;
+    QHash<int, QSet<int>> developerIndex;
+
+    // Незавершённые задачи с дедлайном в порядке дедлайна: задачи, которые могли сменить
+    // корзину срочности за прошедшее время, лежат в нескольких непрерывных диапазонах
+    QMultiMap<QDateTime, int> deadlineIndex;
+
+    // Счётчики статистики. Корзины дедлайнов разложены относительно statsTime;
+    // advanceDeadlines() сдвигает его и запоминает сменившие корзину задачи
+    BoardStats stats;
+    QDateTime statsTime;
+    QSet<int> urgencyChanged;
+
+    SearchIndex searchIndex;
+    QSet<int> unindexedHistory; // Задачи, чья история из файла ещё не в индексе поиска
+    bool historyContains(const Task& task, const QString& folded) const;
+
+    bool batching = false; // Идёт applyBatch(): уведомления задач не обрабатываются
+    UndoStack undoStack;
+
+    void eraseTask(int taskId);         // Убрать задачу из хранилища (индексы не трогает)
+    void compactTasks();                // Закрыть пустые позиции, оставленные eraseTask()
+    int firstHole = -1;                 // Первая пустая позиция в tasks (-1 - нет)
+    void eraseDeveloper(int developerId); // Убрать разработчика из списка (задачи не трогает)
+    void compactDevelopers();             // Закрыть пустые позиции, оставленные eraseDeveloper()
+    int firstDeveloperHole = -1;          // Первая пустая позиция в developers (-1 - нет)
+    void indexTask(const Task& task);   // Добавить задачу во вторичные индексы и статистику
+    void unindexTask(const Task& task); // Убрать задачу из вторичных индексов и статистики
+    void accountTask(int taskId, TaskStatus status, int developerId, const QDateTime& deadline, int delta);
+    void accountDeadline(int taskId, TaskStatus status, const QDateTime& deadline, int delta);
+    void countDeadline(DeadlineBucket bucket, int delta);
+    void resetStats();
+    int advanceDeadlines(const QDateTime& now);
+
+    // Журнал изменений для takeChanges()
+    BoardChanges pendingChanges;
+    void markChanged(int taskId);
+    void markRemoved(int taskId);
+    QList<Task*> resolveTasks(const QSet<int>& ids);
+    bool ownsTask(const Task& task) const; // Принадлежит ли именно этот объект доске
+
+    QString historyFileName; // Файл *.sbb, из которого задачи читают историю по требованию
+
+    // Журнал на диске и сквозной номер изменений доски
+    std::unique_ptr<BoardJournal> journal;
+    QString journalBoardFile;
+    quint64 journalSequence = 0;
+    quint64 nextSequence() { return ++journalSequence; }
+    quint64 revision = 0;
+
+    static bool saveJson(const BoardSnapshot& snapshot, const QString& filename, const SaveProgress& progress);
+    static bool readJson(const QString& filename, const LoadProgress& progress, BoardSnapshot& loaded);
+    static bool readBinary(const QString& filename, const LoadProgress& progress, BoardSnapshot& loaded);
+    bool loadSnapshot(const QString& filename, const QString& journalFilename, const LoadProgress& progress);
+    void replaceContents(const BoardSnapshot& loaded);
 
-    QJsonObject toJson() const; //Создает JSON представление объекта
-    void fromJson(const QJsonObject& json); // Восстанавливает объект из JSON
+    // TaskObserver
+    void taskStatusChanged(const Task& task, TaskStatus oldStatus) override;
+    void taskTitleChanged(const Task& task, const QString& oldTitle) override;
+    void taskDescriptionChanged(const Task& task, const QString& oldDescription) override;
+    void taskAssigneeChanged(const Task& task, int oldDeveloperId) override;
+    void taskDeadlineChanged(const Task& task, const QDateTime& oldDeadline) override;
+    void taskHistoryAppended(const Task& task, const TaskHistoryEntry& entry) override;
 };
 
 #endif // BOARD_H
\ No newline at end of file
@@ -0,0 +1,277 @@
+#include "boardjournal.h"
+#include <QHash>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSet>
+#include <utility>
+#ifdef Q_OS_WIN
+#include <io.h>     // _commit
+#else
+#include <unistd.h> // fsync
+#endif
+
+QString BoardJournal::journalFileName(const QString& boardFilename) {
+    return boardFilename + ".journal";
+}
+
+BoardJournal::BoardJournal(const QString& boardFilename)
+    : file(journalFileName(boardFilename)) {
+}
+
+BoardJournal::~BoardJournal() {
+    if (file.isOpen()) {
+        sync();
+    }
+}
+
+bool BoardJournal::open() {
+    return file.open(QIODevice::WriteOnly | QIODevice::Append);
+}
+
+bool BoardJournal::writeBuffer() {
+    if (buffer.isEmpty()) {
+        return true;
+    }
+    if (!file.isOpen() || file.write(buffer) != buffer.size()) {
+        return false;
+    }
+    buffer.resize(0);
+    return file.flush(); // Из буфера QFile в систему; на диск - только в sync()
+}
+
+bool BoardJournal::sync() {
+    if (!writeBuffer()) {
+        return false;
+    }
+    if (pending == 0) {
+        return true;
+    }
+    pending = 0;
+    // Один fsync на всю пачку записей
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return ::fsync(file.handle()) == 0;
+#endif
+}
+
+bool BoardJournal::truncate() {
+    buffer.resize(0);
+    pending = 0;
+    return file.resize(0);
+}
+
+void BoardJournal::finishRecord() {
+    pending++;
+    if (buffer.size() >= flushThreshold) {
+        writeBuffer(); // Большой буфер сбрасываем сразу, fsync остаётся за sync()
+    }
+}
+
+namespace {
+
+QByteArray recordLine(quint64 seq, const QString& op, QJsonObject record) {
+    record["seq"] = double(seq); // Номера до 2^53 представимы в JSON точно
+    record["op"] = op;
+    return QJsonDocument(record).toJson(QJsonDocument::Compact) + '\n';
+}
+
+// Убрать элементы с номерами из removed одним проходом, сохранив порядок остальных
+template <typename T>
+void removeSlots(QList<T>& items, const QSet<int>& removed) {
+    if (removed.isEmpty()) {
+        return;
+    }
+    int kept = 0;
+    for (int i = 0; i < items.size(); i++) {
+        if (!removed.contains(i)) {
+            if (kept != i) {
+                items[kept] = std::move(items[i]);
+            }
+            kept++;
+        }
+    }
+    items.erase(items.begin() + kept, items.end());
+}
+
+// Поставить элемент на место index (так отмена удаления возвращает его на прежнее место).
+// Сначала закрываются пустые позиции removed, затем номера в slots пересчитываются заново.
+// Стоит O(списка), но такие записи редки
+template <typename T>
+void placeAt(QList<T>& items, QHash<int, int>& slots, QSet<int>& removed, const T& item, int index) {
+    removeSlots(items, removed);
+    removed.clear();
+    for (int i = 0; i < items.size(); i++) {
+        if (items[i].getId() == item.getId()) {
+            items.removeAt(i);
+            break;
+        }
+    }
+    items.insert(qMin(index, int(items.size())), item);
+    slots.clear();
+    for (int i = 0; i < items.size(); i++) {
+        slots.insert(items[i].getId(), i);
+    }
+}
+
+} // namespace
+
+void BoardJournal::recordTask(quint64 seq, const Task& task, int index) {
+    QJsonObject record;
+    record["task"] = task.toJson();
+    if (index >= 0) {
+        record["index"] = index;
+    }
+    buffer.append(recordLine(seq, "task", record));
+    finishRecord();
+}
+
+void BoardJournal::recordTaskRemoved(quint64 seq, int taskId) {
+    QJsonObject record;
+    record["id"] = taskId;
+    buffer.append(recordLine(seq, "remove_task", record));
+    finishRecord();
+}
+
+void BoardJournal::recordDeveloper(quint64 seq, const Developer& developer, int index) {
+    QJsonObject record;
+    record["developer"] = developer.toJson();
+    if (index >= 0) {
+        record["index"] = index;
+    }
+    buffer.append(recordLine(seq, "developer", record));
+    finishRecord();
+}
+
+void BoardJournal::recordDeveloperRemoved(quint64 seq, int developerId) {
+    QJsonObject record;
+    record["id"] = developerId;
+    buffer.append(recordLine(seq, "remove_developer", record));
+    finishRecord();
+}
+
+void BoardJournal::recordField(quint64 seq, int taskId, const QString& field, const QString& value) {
+    QJsonObject record;
+    record["id"] = taskId;
+    record["field"] = field;
+    record["value"] = value;
+    buffer.append(recordLine(seq, "set", record));
+    finishRecord();
+}
+
+void BoardJournal::recordField(quint64 seq, int taskId, const QString& field, int value) {
+    QJsonObject record;
+    record["id"] = taskId;
+    record["field"] = field;
+    record["value"] = value;
+    buffer.append(recordLine(seq, "set", record));
+    finishRecord();
+}
+
+void BoardJournal::recordHistory(quint64 seq, int taskId, const TaskHistoryEntry& entry) {
+    QJsonObject record;
+    record["id"] = taskId;
+    record["entry"] = entry.toJson();
+    buffer.append(recordLine(seq, "history", record));
+    finishRecord();
+}
+
+void BoardJournal::replay(const QString& journalFilename, quint64& sequence,
+                          QList<Developer>& developers, QList<Task>& tasks) {
+    QFile journal(journalFilename);
+    if (!journal.open(QIODevice::ReadOnly)) {
+        return; // Журнала нет - снимок актуален
+    }
+
+    QHash<int, int> taskSlots;
+    for (int i = 0; i < tasks.size(); i++) {
+        taskSlots.insert(tasks[i].getId(), i);
+    }
+    QSet<int> removedSlots; // Удалённые задачи убираются из списка одним проходом в конце
+    QHash<int, int> developerSlots;
+    QSet<int> removedDeveloperSlots;
+    for (int i = 0; i < developers.size(); i++) {
+        developerSlots.insert(developers[i].getId(), i);
+    }
+
+    while (!journal.atEnd()) {
+        QByteArray line = journal.readLine().trimmed();
+        if (line.isEmpty()) {
+            continue;
+        }
+        QJsonParseError parseError;
+        QJsonDocument doc = QJsonDocument::fromJson(line, &parseError);
+        if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+            break; // Оборванная запись - после неё данных нет
+        }
+
+        QJsonObject record = doc.object();
+        quint64 seq = quint64(record["seq"].toDouble());
+        if (seq <= sequence) {
+            continue; // Уже вошло в снимок
+        }
+        sequence = seq;
+
+        QString op = record["op"].toString();
+        int id = record["id"].toInt();
+        int index = record["index"].toInt(-1);
+        if (op == "task") {
+            Task task = Task::parseJson(record["task"].toObject());
+            auto it = taskSlots.constFind(task.getId());
+            if (index >= 0) {
+                placeAt(tasks, taskSlots, removedSlots, task, index);
+            } else if (it != taskSlots.constEnd()) {
+                tasks[it.value()] = task;
+            } else {
+                taskSlots.insert(task.getId(), tasks.size());
+                tasks.append(task);
+            }
+        } else if (op == "remove_task") {
+            auto it = taskSlots.find(id);
+            if (it == taskSlots.end()) continue;
+            removedSlots.insert(it.value());
+            taskSlots.erase(it);
+        } else if (op == "developer") {
+            Developer dev = Developer::parseJson(record["developer"].toObject());
+            auto it = developerSlots.constFind(dev.getId());
+            if (index >= 0) {
+                placeAt(developers, developerSlots, removedDeveloperSlots, dev, index);
+            } else if (it != developerSlots.constEnd()) {
+                developers[it.value()] = dev;
+            } else {
+                developerSlots.insert(dev.getId(), developers.size());
+                developers.append(dev);
+            }
+        } else if (op == "remove_developer") {
+            auto it = developerSlots.find(id);
+            if (it == developerSlots.end()) continue;
+            removedDeveloperSlots.insert(it.value());
+            developerSlots.erase(it);
+        } else if (taskSlots.contains(id)) {
+            // Поля задачи меняем напрямую: запись истории о правке идёт в журнале отдельно
+            Task& task = tasks[taskSlots.value(id)];
+            if (op == "history") {
+                task.history.append(TaskHistoryEntry::fromJson(record["entry"].toObject()));
+            } else if (op == "set") {
+                QString field = record["field"].toString();
+                QJsonValue value = record["value"];
+                if (field == "title") {
+                    task.title = value.toString();
+                } else if (field == "description") {
+                    task.description = value.toString();
+                } else if (field == "status") {
+                    task.status = Task::stringToStatus(value.toString());
+                } else if (field == "assignee") {
+                    task.assignedDeveloperId = value.toInt();
+                } else if (field == "deadline") {
+                    QString deadline = value.toString();
+                    task.deadline = deadline.isEmpty() ? QDateTime() : QDateTime::fromString(deadline, Qt::ISODate);
+                }
+            }
+        }
+    }
+
+    // Как и на доске, удаление не меняет порядок остальных задач и разработчиков
+    removeSlots(tasks, removedSlots);
+    removeSlots(developers, removedDeveloperSlots);
+}
@@ -0,0 +1,60 @@
+#ifndef BOARDJOURNAL_H
+#define BOARDJOURNAL_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QList>
+#include <QString>
+#include "task.h"
+#include "developer.h"
+
+// Журнал изменений доски (write-ahead log) рядом с файлом доски: "<файл>.journal".
+// Каждое изменение - одна строка JSON с порядковым номером seq:
+//   {"seq":12,"op":"set","id":5,"field":"status","value":"Done"}
+//   {"seq":13,"op":"history","id":5,"entry":{...}}
+// Записи копятся в буфере и записываются в файл с одним fsync на пачку (sync()),
+// так что сохранение одного изменения стоит O(1) ввода-вывода, а не O(доски).
+// Снимок доски хранит номер последней вошедшей в него записи; при восстановлении
+// журнал проигрывается поверх снимка начиная со следующей записи.
+class BoardJournal {
+public:
+    static QString journalFileName(const QString& boardFilename);
+
+    explicit BoardJournal(const QString& boardFilename);
+    ~BoardJournal(); // Дописывает и синхронизирует буфер
+
+    bool open();     // Открыть журнал для дозаписи (создаётся при необходимости)
+    bool sync();     // Записать накопленные записи и дождаться их попадания на диск
+    bool truncate(); // Очистить журнал после того, как снимок включил все записи
+
+    qint64 size() const { return file.size() + buffer.size(); }
+    int pendingRecords() const { return pending; }
+
+    // Запись изменений. seq - сквозной номер изменения доски. index >= 0 - задача или
+    // разработчик стоит на этом месте списка (отмена удаления вернула его на прежнее место)
+    void recordTask(quint64 seq, const Task& task, int index = -1);
+    void recordTaskRemoved(quint64 seq, int taskId);
+    void recordDeveloper(quint64 seq, const Developer& developer, int index = -1);
+    void recordDeveloperRemoved(quint64 seq, int developerId);
+    void recordField(quint64 seq, int taskId, const QString& field, const QString& value);
+    void recordField(quint64 seq, int taskId, const QString& field, int value);
+    void recordHistory(quint64 seq, int taskId, const TaskHistoryEntry& entry);
+
+    // Проиграть журнал journalFilename поверх загруженного снимка. Применяются записи
+    // с номером больше sequence; sequence обновляется до последней применённой.
+    // Оборванная последняя строка (сбой во время записи) пропускается
+    static void replay(const QString& journalFilename, quint64& sequence,
+                       QList<Developer>& developers, QList<Task>& tasks);
+
+private:
+    static const int flushThreshold = 64 * 1024;
+
+    QFile file;
+    QByteArray buffer;
+    int pending = 0; // Записей после последнего sync()
+
+    void finishRecord();
+    bool writeBuffer();
+};
+
+#endif // BOARDJOURNAL_H
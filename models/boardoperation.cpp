@@ -0,0 +1,73 @@
+#include "boardoperation.h"
+
+BoardOperation BoardOperation::addTask(const Task& task, int position) {
+    BoardOperation operation;
+    operation.type = AddTask;
+    operation.taskId = task.getId();
+    operation.task = task;
+    operation.position = position;
+    return operation;
+}
+
+BoardOperation BoardOperation::removeTask(int taskId) {
+    BoardOperation operation;
+    operation.type = RemoveTask;
+    operation.taskId = taskId;
+    return operation;
+}
+
+BoardOperation BoardOperation::setStatus(int taskId, TaskStatus status) {
+    BoardOperation operation;
+    operation.type = SetStatus;
+    operation.taskId = taskId;
+    operation.status = status;
+    return operation;
+}
+
+BoardOperation BoardOperation::assign(int taskId, int developerId) {
+    BoardOperation operation;
+    operation.type = Assign;
+    operation.taskId = taskId;
+    operation.developerId = developerId;
+    return operation;
+}
+
+BoardOperation BoardOperation::setDeadline(int taskId, const QDateTime& deadline) {
+    BoardOperation operation;
+    operation.type = SetDeadline;
+    operation.taskId = taskId;
+    operation.deadline = deadline;
+    return operation;
+}
+
+BoardOperation BoardOperation::setTitle(int taskId, const QString& title) {
+    BoardOperation operation;
+    operation.type = SetTitle;
+    operation.taskId = taskId;
+    operation.text = title;
+    return operation;
+}
+
+BoardOperation BoardOperation::setDescription(int taskId, const QString& description) {
+    BoardOperation operation;
+    operation.type = SetDescription;
+    operation.taskId = taskId;
+    operation.text = description;
+    return operation;
+}
+
+BoardOperation BoardOperation::addDeveloper(const Developer& developer, int position) {
+    BoardOperation operation;
+    operation.type = AddDeveloper;
+    operation.developerId = developer.getId();
+    operation.developer = developer;
+    operation.position = position;
+    return operation;
+}
+
+BoardOperation BoardOperation::removeDeveloper(int developerId) {
+    BoardOperation operation;
+    operation.type = RemoveDeveloper;
+    operation.developerId = developerId;
+    return operation;
+}
@@ -0,0 +1,48 @@
+#ifndef BOARDOPERATION_H
+#define BOARDOPERATION_H
+
+#include <QDateTime>
+#include <QString>
+#include <optional>
+#include "task.h"
+#include "developer.h"
+
+// Одна операция изменения доски: элемент пакета Board::applyBatch
+// и запись стека отмены (UndoStack хранит прямые и обратные операции)
+struct BoardOperation {
+    enum Type {
+        AddTask,         // task; задача с существующим ID заменяет старую
+        RemoveTask,      // taskId
+        SetStatus,       // taskId, status
+        Assign,          // taskId, developerId (-1 - снять назначение)
+        SetDeadline,     // taskId, deadline (невалидная дата - убрать дедлайн)
+        SetTitle,        // taskId, text
+        SetDescription,  // taskId, text
+        AddDeveloper,    // developer; разработчик с существующим ID заменяет старого
+        RemoveDeveloper  // developerId; задачи разработчика остаются без назначения
+    };
+
+    Type type = SetStatus;
+    int taskId = -1;
+    std::optional<Task> task; // Только для AddTask
+    TaskStatus status = TaskStatus::Backlog;
+    int developerId = -1;
+    QDateTime deadline;
+    QString text;                       // Название или описание
+    std::optional<Developer> developer; // Только для AddDeveloper
+    // AddTask/AddDeveloper: место нового элемента в списке, каким он был до пакета
+    // (-1 - в конец). Так отмена удаления возвращает задачу или разработчика на прежнее место
+    int position = -1;
+
+    static BoardOperation addTask(const Task& task, int position = -1);
+    static BoardOperation removeTask(int taskId);
+    static BoardOperation setStatus(int taskId, TaskStatus status);
+    static BoardOperation assign(int taskId, int developerId);
+    static BoardOperation setDeadline(int taskId, const QDateTime& deadline);
+    static BoardOperation setTitle(int taskId, const QString& title);
+    static BoardOperation setDescription(int taskId, const QString& description);
+    static BoardOperation addDeveloper(const Developer& developer, int position = -1);
+    static BoardOperation removeDeveloper(int developerId);
+};
+
+#endif // BOARDOPERATION_H
@@ -0,0 +1,643 @@
+#include "boardquery.h"
+#include "board.h"
+#include "trace.h"
+#include <QStringList>
+#include <algorithm>
+
+using Node = BoardQuery::Node;
+
+namespace {
+
+// Задачи просматриваются блоками: каждое условие проверяется сразу для всего блока
+const int scanBlockSize = 1024;
+// Когда после пересечения индексов кандидатов остаётся не больше этого числа,
+// остальные условия дешевле проверить у самих задач, чем читать их индексы
+const int filterThreshold = 64;
+
+struct HistoryName {
+    const char* name;
+    HistoryAction action;
+};
+
+const HistoryName historyNames[] = {
+    {"created", HistoryAction::Created},
+    {"title", HistoryAction::TitleChanged},
+    {"description", HistoryAction::DescriptionChanged},
+    {"status", HistoryAction::StatusChanged},
+    {"assigned", HistoryAction::Assigned},
+    {"unassigned", HistoryAction::Unassigned},
+    {"deadline", HistoryAction::DeadlineSet},
+    {"nodeadline", HistoryAction::DeadlineRemoved},
+    {"custom", HistoryAction::Custom},
+};
+
+struct Token {
+    enum Type { Word, Open, Close, Or, And, Not };
+    Type type = Word;
+    QString text;
+    int colon = -1; // Позиция первого ':' вне кавычек: до него имя поля, после - значение
+};
+
+bool fail(QString* errorText, const QString& error) {
+    if (errorText) {
+        *errorText = error;
+    }
+    return false;
+}
+
+bool tokenize(const QString& text, QVector<Token>& tokens, QString* errorText) {
+    int i = 0;
+    while (i < text.size()) {
+        QChar c = text[i];
+        if (c.isSpace()) {
+            i++;
+            continue;
+        }
+        Token token;
+        if (c == '(' || c == ')') {
+            token.type = c == '(' ? Token::Open : Token::Close;
+            token.text = c;
+            tokens.append(token);
+            i++;
+            continue;
+        }
+        if (c == '-' && i + 1 < text.size() && !text[i + 1].isSpace()) {
+            token.type = Token::Not; // "-условие"
+            token.text = c;
+            tokens.append(token);
+            i++;
+            continue;
+        }
+
+        bool quoted = false;
+        bool hasQuotes = false;
+        for (; i < text.size(); i++) {
+            c = text[i];
+            if (c == '"') {
+                quoted = !quoted;
+                hasQuotes = true;
+                continue;
+            }
+            if (!quoted && (c.isSpace() || c == '(' || c == ')')) {
+                break;
+            }
+            if (!quoted && c == ':' && token.colon < 0) {
+                token.colon = token.text.size();
+            }
+            token.text.append(c);
+        }
+        if (quoted) {
+            return fail(errorText, "не закрыта кавычка");
+        }
+        // Операторы - только заглавными и без кавычек: "or" в тексте остаётся словом
+        if (!hasQuotes && token.text == "OR") {
+            token.type = Token::Or;
+        } else if (!hasQuotes && token.text == "AND") {
+            token.type = Token::And;
+        } else if (!hasQuotes && token.text == "NOT") {
+            token.type = Token::Not;
+        }
+        tokens.append(token);
+    }
+    return true;
+}
+
+// Разбор по грамматике: запрос = и (OR и)*; и = унарное ([AND] унарное)*;
+// унарное = (NOT | -) унарное | ( запрос ) | условие
+// Разбор и обход дерева рекурсивны, поэтому вложенность скобок и отрицаний ограничена
+class Parser {
+public:
+    Parser(const QVector<Token>& tokens, QString* errorText) : tokens(tokens), errorText(errorText) {}
+
+    bool structured = false; // Встретились поля, операторы или скобки
+
+    bool parseQuery(Node& node) {
+        if (tokens.isEmpty()) {
+            node = Node(); // Пустое И - все задачи
+            return true;
+        }
+        if (!parseOr(node)) {
+            return false;
+        }
+        if (pos < tokens.size()) {
+            return fail(errorText, "лишняя закрывающая скобка");
+        }
+        return true;
+    }
+
+private:
+    static const int maxDepth = 100; // Вложенных унарных условий (скобок и отрицаний)
+
+    const QVector<Token>& tokens;
+    QString* errorText;
+    int pos = 0;
+    int depth = 0;
+
+    bool at(Token::Type type) const { return pos < tokens.size() && tokens[pos].type == type; }
+
+    bool parseOr(Node& node) {
+        if (!parseAnd(node)) {
+            return false;
+        }
+        if (!at(Token::Or)) {
+            return true;
+        }
+        Node alternatives;
+        alternatives.type = Node::Or;
+        alternatives.children.push_back(std::move(node));
+        while (at(Token::Or)) {
+            pos++;
+            structured = true;
+            Node next;
+            if (!parseAnd(next)) {
+                return false;
+            }
+            alternatives.children.push_back(std::move(next));
+        }
+        node = std::move(alternatives);
+        return true;
+    }
+
+    bool parseAnd(Node& node) {
+        Node all;
+        all.type = Node::And;
+        do {
+            if (at(Token::And)) {
+                pos++;
+                structured = true;
+            }
+            Node next;
+            if (!parseUnary(next)) {
+                return false;
+            }
+            all.children.push_back(std::move(next));
+        } while (pos < tokens.size() && !at(Token::Close) && !at(Token::Or));
+
+        if (all.children.size() == 1) {
+            node = std::move(all.children.front());
+        } else {
+            node = std::move(all);
+        }
+        return true;
+    }
+
+    bool parseUnary(Node& node) {
+        if (depth >= maxDepth) {
+            return fail(errorText, QString("слишком глубокая вложенность (больше %1)").arg(maxDepth));
+        }
+        depth++;
+        bool parsed = parseNested(node);
+        depth--;
+        return parsed;
+    }
+
+    bool parseNested(Node& node) {
+        if (pos >= tokens.size()) {
+            return fail(errorText, "запрос оборвался: не хватает условия");
+        }
+        const Token& token = tokens[pos++];
+        switch (token.type) {
+        case Token::Not: {
+            structured = true;
+            Node child;
+            if (!parseUnary(child)) {
+                return false;
+            }
+            node = Node();
+            node.type = Node::Not;
+            node.children.push_back(std::move(child));
+            return true;
+        }
+        case Token::Open:
+            structured = true;
+            if (!parseOr(node)) {
+                return false;
+            }
+            if (!at(Token::Close)) {
+                return fail(errorText, "не хватает закрывающей скобки");
+            }
+            pos++;
+            return true;
+        case Token::Word:
+            return parseTerm(token, node);
+        default:
+            return fail(errorText, QString("неожиданное \"%1\"").arg(token.text));
+        }
+    }
+
+    bool parseTerm(const Token& token, Node& node) {
+        if (token.colon < 0) {
+            node.type = Node::Text;
+            node.text = token.text;
+            return true;
+        }
+        structured = true;
+        const QString key = token.text.left(token.colon).toLower();
+        const QString value = token.text.mid(token.colon + 1);
+        if (value.isEmpty()) {
+            return fail(errorText, QString("не указано значение поля %1").arg(key));
+        }
+
+        if (key == "status") {
+            node.type = Node::Status;
+            for (int i = 0; i < 5; i++) {
+                if (Task::statusToString(TaskStatus(i)).compare(value, Qt::CaseInsensitive) == 0) {
+                    node.status = TaskStatus(i);
+                    return true;
+                }
+            }
+            return fail(errorText, "неизвестный статус: " + value);
+        }
+        if (key == "assignee") {
+            node.type = Node::Assignee;
+            if (value.compare(QLatin1String("none"), Qt::CaseInsensitive) == 0) {
+                node.developerId = -1;
+                return true;
+            }
+            bool ok = false;
+            node.developerId = value.toInt(&ok);
+            if (!ok || node.developerId < 0) {
+                return fail(errorText, "ID разработчика должен быть числом или none: " + value);
+            }
+            return true;
+        }
+        if (key == "due") {
+            node.type = Node::Due;
+            const int dots = value.indexOf("..");
+            const QString from = dots < 0 ? value : value.left(dots);
+            const QString to = dots < 0 ? value : value.mid(dots + 2);
+            node.from = QDate::fromString(from, Qt::ISODate);
+            node.to = QDate::fromString(to, Qt::ISODate);
+            if ((!from.isEmpty() && !node.from.isValid()) || (!to.isEmpty() && !node.to.isValid())) {
+                return fail(errorText, "неверная дата (нужно ГГГГ-ММ-ДД): " + value);
+            }
+            if (!node.from.isValid() && !node.to.isValid()) {
+                return fail(errorText, "не указаны границы дедлайна: " + value);
+            }
+            return true;
+        }
+        if (key == "is") {
+            if (value.compare(QLatin1String("overdue"), Qt::CaseInsensitive) != 0) {
+                return fail(errorText, "неизвестное значение is: " + value);
+            }
+            node.type = Node::Overdue;
+            return true;
+        }
+        if (key == "history") {
+            node.type = Node::History;
+            for (const HistoryName& name : historyNames) {
+                if (value.compare(QLatin1String(name.name), Qt::CaseInsensitive) == 0) {
+                    node.action = name.action;
+                    return true;
+                }
+            }
+            return fail(errorText, "неизвестное действие истории: " + value);
+        }
+        if (key == "text") {
+            node.type = Node::Text;
+            node.text = value;
+            return true;
+        }
+        return fail(errorText, "неизвестное поле: " + key);
+    }
+};
+
+// Границы дедлайна для due: [начало первого дня, начало дня после последнего)
+void dueRange(const Node& node, QDateTime& from, QDateTime& to) {
+    from = node.from.isValid() ? QDateTime(node.from, QTime(0, 0)) : QDateTime();
+    to = node.to.isValid() ? QDateTime(node.to.addDays(1), QTime(0, 0)) : QDateTime();
+}
+
+bool isCompound(const Node& node) {
+    return (node.type == Node::And || node.type == Node::Or) && node.children.size() > 1;
+}
+
+// Оставить в selection задачи, подходящие под pred; порядок сохраняется
+template <typename Predicate>
+void compact(QVector<const Task*>& selection, Predicate pred) {
+    selection.erase(std::remove_if(selection.begin(), selection.end(),
+                                   [&pred](const Task* task) { return !pred(*task); }),
+                    selection.end());
+}
+
+// Убрать из selection задачи part (part - подпоследовательность selection)
+void subtract(QVector<const Task*>& selection, const QVector<const Task*>& part) {
+    int k = 0;
+    int kept = 0;
+    for (int i = 0; i < selection.size(); i++) {
+        if (k < part.size() && part[k] == selection[i]) {
+            k++;
+        } else {
+            selection[kept++] = selection[i];
+        }
+    }
+    selection.resize(kept);
+}
+
+} // namespace
+
+bool BoardQuery::parse(const QString& text, BoardQuery& query, QString* errorText) {
+    QVector<Token> tokens;
+    if (!tokenize(text, tokens, errorText)) {
+        return false;
+    }
+    Parser parser(tokens, errorText);
+    Node root;
+    if (!parser.parseQuery(root)) {
+        return false;
+    }
+    query.root = std::move(root);
+    query.structured = parser.structured;
+    return true;
+}
+
+QString BoardQuery::plainText() const {
+    if (root.type == Node::Text) {
+        return root.text;
+    }
+    QStringList words;
+    for (const Node& child : root.children) {
+        words.append(child.text);
+    }
+    return words.join(' ');
+}
+
+QString BoardQuery::describe(const Node& node) {
+    auto operand = [](const Node& child) {
+        return isCompound(child) ? "(" + describe(child) + ")" : describe(child);
+    };
+    switch (node.type) {
+    case Node::And:
+    case Node::Or: {
+        if (node.children.empty()) {
+            return "*"; // Все задачи
+        }
+        QStringList parts;
+        for (const Node& child : node.children) {
+            parts.append(operand(child));
+        }
+        return parts.join(node.type == Node::And ? " AND " : " OR ");
+    }
+    case Node::Not:
+        return "-" + operand(node.children.front());
+    case Node::Status:
+        return "status:" + Task::statusToString(node.status);
+    case Node::Assignee:
+        return node.developerId < 0 ? QString("assignee:none") : QString("assignee:%1").arg(node.developerId);
+    case Node::Due:
+        if (node.from == node.to) {
+            return "due:" + node.from.toString(Qt::ISODate);
+        }
+        return "due:" + node.from.toString(Qt::ISODate) + ".." + node.to.toString(Qt::ISODate);
+    case Node::Overdue:
+        return "is:overdue";
+    case Node::Text:
+        return "text:\"" + node.text + "\"";
+    case Node::History:
+        for (const HistoryName& name : historyNames) {
+            if (name.action == node.action) {
+                return QString("history:") + name.name;
+            }
+        }
+        break;
+    }
+    return QString();
+}
+
+QueryResult BoardQuery::run(const Board& board) const {
+    TRACE_SCOPE("BoardQuery::run");
+    QueryResult result;
+    // is:overdue - относительно момента последнего Board::updateDeadlines(), как и статистика
+
+    result.plan = "Запрос: " + describe(root) + "\n";
+    if (indexable(root)) {
+        result.usedIndex = true;
+        result.plan += "План: по индексам доски\n";
+        result.ids = lookup(board, root, result, 1);
+    } else {
+        result.plan += QString("План: просмотр всех задач блоками по %1\n").arg(scanBlockSize);
+        result.plan += "  " + describe(root) + " - индексом не покрывается\n";
+        scan(board, root, board.tasks, result.ids, result);
+    }
+    result.plan += QString("Найдено: %1; из индексов прочитано ID: %2, проверено задач: %3 из %4")
+                       .arg(result.ids.size()).arg(result.fromIndex).arg(result.examined).arg(board.tasks.size());
+    return result;
+}
+
+// Можно ли получить точное множество задач узла из индексов доски
+bool BoardQuery::indexable(const Node& node) {
+    switch (node.type) {
+    case Node::Status:
+    case Node::Assignee:
+    case Node::Due:
+    case Node::Overdue:
+    case Node::Text:
+        return true;
+    case Node::And: // Хватает одного индексируемого условия - остальные проверяются у кандидатов
+        return std::any_of(node.children.begin(), node.children.end(), indexable);
+    case Node::Or:
+        return !node.children.empty() && std::all_of(node.children.begin(), node.children.end(), indexable);
+    default: // Отрицание и история: индекса нет
+        return false;
+    }
+}
+
+QSet<int> BoardQuery::lookup(const Board& board, const Node& node, QueryResult& result, int depth) {
+    const QString indent(depth * 2, ' ');
+    QSet<int> ids;
+    switch (node.type) {
+    case Node::Status:
+        ids = board.statusIndex.value(node.status);
+        result.plan += indent + describe(node) + QString(" - индекс статусов: %1\n").arg(ids.size());
+        break;
+    case Node::Assignee:
+        ids = board.developerIndex.value(node.developerId);
+        result.plan += indent + describe(node) + QString(" - индекс разработчиков: %1\n").arg(ids.size());
+        break;
+    case Node::Text:
+        ids = board.searchTasks(node.text);
+        result.plan += indent + describe(node) + QString(" - полнотекстовый индекс: %1\n").arg(ids.size());
+        break;
+    case Node::Due: {
+        QDateTime from, to;
+        dueRange(node, from, to);
+        auto it = from.isValid() ? board.deadlineIndex.lowerBound(from) : board.deadlineIndex.constBegin();
+        for (; it != board.deadlineIndex.constEnd() && (!to.isValid() || it.key() < to); ++it) {
+            ids.insert(it.value());
+        }
+        result.plan += indent + describe(node) + QString(" - индекс дедлайнов: %1\n").arg(ids.size());
+        break;
+    }
+    case Node::Overdue: {
+        // В индексе только незавершённые задачи; просрочены все, чей дедлайн раньше statsTime
+        const auto end = board.deadlineIndex.lowerBound(board.statsTime);
+        for (auto it = board.deadlineIndex.constBegin(); it != end; ++it) {
+            ids.insert(it.value());
+        }
+        result.plan += indent + describe(node) + QString(" - индекс дедлайнов: %1\n").arg(ids.size());
+        break;
+    }
+    case Node::Or:
+        result.plan += indent + "OR - объединение индексов\n";
+        for (const Node& child : node.children) {
+            ids.unite(lookup(board, child, result, depth + 1));
+        }
+        return ids;
+    case Node::And: {
+        // Индексируемые условия - от меньшего множества к большему (размер индексов
+        // статусов и разработчиков известен заранее); остальные проверяются у кандидатов
+        std::vector<const Node*> indexed;
+        std::vector<const Node*> residual;
+        for (const Node& child : node.children) {
+            (indexable(child) ? indexed : residual).push_back(&child);
+        }
+        auto estimate = [&board](const Node* child) -> int {
+            switch (child->type) {
+            case Node::Status: return int(board.statusIndex.value(child->status).size());
+            case Node::Assignee: return int(board.developerIndex.value(child->developerId).size());
+            default: return int(board.tasks.size());
+            }
+        };
+        std::stable_sort(indexed.begin(), indexed.end(), [&estimate](const Node* a, const Node* b) {
+            return estimate(a) < estimate(b);
+        });
+
+        result.plan += indent + "AND - пересечение индексов\n";
+        ids = lookup(board, *indexed.front(), result, depth + 1);
+        size_t next = 1;
+        for (; next < indexed.size() && ids.size() > filterThreshold; next++) {
+            ids.intersect(lookup(board, *indexed[next], result, depth + 1));
+        }
+        residual.insert(residual.begin(), indexed.begin() + next, indexed.end());
+        if (residual.empty()) {
+            return ids;
+        }
+
+        Node rest;
+        for (const Node* child : residual) {
+            rest.children.push_back(*child);
+            result.plan += indent + "  " + describe(*child) + " - проверка у кандидатов\n";
+        }
+        QVector<Task*> candidates;
+        candidates.reserve(ids.size());
+        for (int taskId : ids) {
+            candidates.append(board.tasks[board.taskSlots.value(taskId)]);
+        }
+        ids.clear();
+        scan(board, rest, candidates, ids, result);
+        result.plan += indent + QString("  проверено кандидатов: %1, подошло: %2\n")
+                                    .arg(candidates.size()).arg(ids.size());
+        return ids;
+    }
+    default: // Сюда попадают только индексируемые узлы
+        break;
+    }
+    result.fromIndex += ids.size();
+    return ids;
+}
+
+// Просмотр задач блоками: условия отсеивают задачи сразу во всём блоке (выбор типа
+// условия - один раз на блок, а не на задачу), следующему условию идут только прошедшие
+void BoardQuery::scan(const Board& board, const Node& node, const QVector<Task*>& tasks,
+                      QSet<int>& ids, QueryResult& result) {
+    QVector<const Task*> selection;
+    selection.reserve(scanBlockSize);
+    for (int start = 0; start < tasks.size(); start += scanBlockSize) {
+        const int end = qMin(start + scanBlockSize, int(tasks.size()));
+        selection.clear();
+        for (int i = start; i < end; i++) {
+            selection.append(tasks[i]);
+        }
+        filter(board, node, selection);
+        for (const Task* task : selection) {
+            ids.insert(task->getId());
+        }
+    }
+    result.examined += tasks.size();
+}
+
+// Оставить в selection подходящие под узел задачи. Порядок сохраняется: результат -
+// подпоследовательность входа (на этом держится вычитание для NOT и OR)
+void BoardQuery::filter(const Board& board, const Node& node, QVector<const Task*>& selection) {
+    switch (node.type) {
+    case Node::And:
+        for (const Node& child : node.children) {
+            if (selection.isEmpty()) {
+                break;
+            }
+            filter(board, child, selection);
+        }
+        break;
+    case Node::Or: {
+        // Каждая ветка проверяет только задачи, не подошедшие предыдущим
+        QVector<const Task*> rest = selection;
+        for (const Node& child : node.children) {
+            QVector<const Task*> part = rest;
+            filter(board, child, part);
+            subtract(rest, part);
+        }
+        subtract(selection, rest);
+        break;
+    }
+    case Node::Not: {
+        QVector<const Task*> part = selection;
+        filter(board, node.children.front(), part);
+        subtract(selection, part);
+        break;
+    }
+    case Node::Status:
+        compact(selection, [&node](const Task& task) { return task.getStatus() == node.status; });
+        break;
+    case Node::Assignee:
+        compact(selection, [&node](const Task& task) { return task.getAssignedDeveloperId() == node.developerId; });
+        break;
+    case Node::Due: {
+        QDateTime from, to;
+        dueRange(node, from, to);
+        compact(selection, [&from, &to](const Task& task) {
+            const QDateTime deadline = task.getDeadline();
+            return task.getStatus() != TaskStatus::Done && deadline.isValid()
+                   && (!from.isValid() || deadline >= from) && (!to.isValid() || deadline < to);
+        });
+        break;
+    }
+    case Node::Overdue:
+        compact(selection, [&board](const Task& task) {
+            return board.getDeadlineBucket(task) == DeadlineBucket::Overdue;
+        });
+        break;
+    case Node::Text:
+        compact(selection, [&board, &node](const Task& task) {
+            return board.taskMatchesSearch(task.getId(), node.text);
+        });
+        break;
+    case Node::History:
+        compact(selection, [&node](const Task& task) {
+            for (const TaskHistoryEntry& entry : task.getHistory()) {
+                if (entry.getActionCode() == node.action) {
+                    return true;
+                }
+            }
+            return false;
+        });
+        break;
+    }
+}
+
+bool BoardQuery::test(const Board& board, const Node& node, const Task& task) {
+    switch (node.type) {
+    case Node::And:
+        return std::all_of(node.children.begin(), node.children.end(),
+                           [&](const Node& child) { return test(board, child, task); });
+    case Node::Or:
+        return std::any_of(node.children.begin(), node.children.end(),
+                           [&](const Node& child) { return test(board, child, task); });
+    case Node::Not:
+        return !test(board, node.children.front(), task);
+    default: { // Условие на одну задачу - блок из одного элемента
+        QVector<const Task*> selection{&task};
+        filter(board, node, selection);
+        return !selection.isEmpty();
+    }
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef BOARDQUERY_H
+#define BOARDQUERY_H
+
+#include <QDate>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <vector>
+#include "task.h"
+#include "taskhistory.h"
+
+class Board;
+
+// Результат запроса к доске
+struct QueryResult {
+    QSet<int> ids;          // Найденные задачи
+    bool usedIndex = false; // Хотя бы часть запроса выполнена по индексам доски
+    int fromIndex = 0;      // Сколько ID прочитано из индексов
+    int examined = 0;       // Сколько задач просмотрено и проверено условиями
+    QString plan;           // Объяснение: какой путь выбран для каждой части запроса
+};
+
+// Запрос к задачам доски. Текст разбирается в дерево условий:
+//   status:Review            статус (Backlog, Assigned, InProgress, Review, Done)
+//   assignee:3, assignee:none  назначенный разработчик по ID; none - без назначения
+//   due:2026-03-01..2026-03-31 незавершённые задачи с дедлайном в диапазоне дат
+//                            (границы включительно, любую можно опустить: due:..2026-03-31)
+//   is:overdue               просроченные задачи (как в статистике доски - на момент
+//                            последнего Board::updateDeadlines())
+//   history:status           в истории есть действие: created, title, description,
+//                            status, assigned, unassigned, deadline, nodeadline, custom
+//   text:"два слова", слово  полнотекстовый поиск (как в поле поиска)
+//   -условие, NOT условие    отрицание
+//   a OR b, a AND b, a b     или / и (И - по умолчанию), скобки группируют
+//
+// Board::query() выполняет запрос. Условия по статусу, разработчику, тексту и дедлайнам
+// берутся из индексов доски; И пересекает их, начиная с самого маленького множества,
+// а остальные условия проверяет только у найденных задач. Если индексом запрос не
+// покрыть (история, отрицание, ИЛИ с неиндексируемой частью), задачи просматриваются
+// блоками: каждое условие проверяется для всего блока сразу, а дальше идут только прошедшие
+class BoardQuery {
+public:
+    struct Node {
+        enum Type { And, Or, Not, Status, Assignee, Due, Overdue, Text, History };
+
+        Type type = And;
+        std::vector<Node> children; // And, Or, Not. Пустое И подходит всем задачам
+        TaskStatus status = TaskStatus::Backlog;
+        int developerId = -1;       // Assignee; -1 - задача не назначена
+        QString text;               // Text
+        QDate from, to;             // Due; невалидная дата - без границы
+        HistoryAction action = HistoryAction::Custom;
+    };
+
+    BoardQuery() = default; // Пустой запрос: подходят все задачи
+
+    // Разобрать текст запроса. При ошибке возвращает false, а в errorText - описание
+    static bool parse(const QString& text, BoardQuery& query, QString* errorText = nullptr);
+
+    // Запрос - просто слова, без полей и операторов (его можно искать как обычный текст)
+    bool isPlainText() const { return !structured; }
+    // Текст простого запроса без кавычек: слова через пробел. Он ищется как фраза,
+    // так что "два слова" и два слова ищутся одинаково
+    QString plainText() const;
+    const Node& getRoot() const { return root; }
+    QString toString() const { return describe(root); } // Запрос в разобранном виде
+
+    // Выполнить запрос по индексам доски
+    QueryResult run(const Board& board) const;
+    // Подходит ли под запрос одна задача доски (без обхода индексов)
+    bool matches(const Board& board, const Task& task) const { return test(board, root, task); }
+
+private:
+    Node root;
+    bool structured = false;
+
+    static QString describe(const Node& node);
+
+    // Выполнение (пользуется закрытыми индексами доски)
+    static bool indexable(const Node& node);
+    static QSet<int> lookup(const Board& board, const Node& node, QueryResult& result, int depth);
+    static void filter(const Board& board, const Node& node, QVector<const Task*>& selection);
+    static bool test(const Board& board, const Node& node, const Task& task);
+    static void scan(const Board& board, const Node& node, const QVector<Task*>& tasks,
+                     QSet<int>& ids, QueryResult& result);
+};
+
+#endif // BOARDQUERY_H
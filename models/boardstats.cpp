@@ -0,0 +1,16 @@
+#include "boardstats.h"
+
+DeadlineBucket BoardStats::deadlineBucket(TaskStatus status, const QDateTime& deadline, const QDateTime& now) {
+    // Те же правила, что у Task::isOverdue() и Task::daysUntilDeadline()
+    if (!deadline.isValid() || status == TaskStatus::Done) {
+        return DeadlineBucket::None;
+    }
+    if (now > deadline) {
+        return DeadlineBucket::Overdue;
+    }
+    qint64 days = now.daysTo(deadline);
+    if (days == 0) {
+        return DeadlineBucket::Today;
+    }
+    return days <= 3 ? DeadlineBucket::Soon : DeadlineBucket::Later;
+}
@@ -0,0 +1,34 @@
+#ifndef BOARDSTATS_H
+#define BOARDSTATS_H
+
+#include "task.h"
+
+// Срочность дедлайна незавершённой задачи
+enum class DeadlineBucket {
+    None,    // Нет дедлайна или задача сделана
+    Overdue, // Просрочено
+    Today,   // Дедлайн сегодня
+    Soon,    // Дедлайн через 1-3 дня
+    Later    // Дедлайн позже
+};
+
+// Сводная статистика доски. Board обновляет счётчики при каждом изменении,
+// поэтому чтение статистики не требует перебора задач.
+struct BoardStats {
+    int total = 0;
+    int byStatus[5] = {0, 0, 0, 0, 0}; // Индекс - значение TaskStatus
+    int unassignedActive = 0;          // Неназначенные задачи вне бэклога
+
+    // Дедлайны незавершённых задач
+    int overdue = 0;
+    int dueToday = 0;
+    int dueSoon = 0;
+
+    int count(TaskStatus status) const { return byStatus[static_cast<int>(status)]; }
+    int percentDone() const { return total > 0 ? count(TaskStatus::Done) * 100 / total : 0; }
+
+    // Корзина срочности задачи с указанным состоянием на момент now
+    static DeadlineBucket deadlineBucket(TaskStatus status, const QDateTime& deadline, const QDateTime& now);
+};
+
+#endif // BOARDSTATS_H
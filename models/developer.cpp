@@ -1,19 +1,30 @@
 #include "developer.h"
+#include "jsonstreamwriter.h"
 
-int Developer::nextId = 1;
+IdAllocator Developer::ids;
 
 Developer::Developer()
-    : id(nextId++),
+    : id(ids.allocate()),
     name(""),
     position("") {
 }
 
 Developer::Developer(const QString& name, const QString& position)
-    : id(nextId++),
+    : id(ids.allocate()),
     name(name),
     position(position) {
 }
 
+Developer::Developer(int id, const QString& name, const QString& position)
+    : id(id),
+    name(name),
+    position(position) {
+}
+
+Developer::Developer(int existingId)
+    : id(existingId) {
+}
+
 QJsonObject Developer::toJson() const {
     QJsonObject json; // 1. Создаём пустой JSON-объект
     json["id"] = id; // 2. Добавляем поле "id"
@@ -22,16 +33,30 @@ QJsonObject Developer::toJson() const {
     return json; // 5. Возвращаем готовый объект
 }
 
-Developer Developer::fromJson(const QJsonObject& json) {
-    Developer dev; // 1. Создаём временный объект
-    dev.id = json["id"].toInt();   // 2. Извлекаем id
-    dev.name = json["name"].toString();
-    dev.position = json["position"].toString();    // 5. Возвращаем объект
+void Developer::writeJson(JsonStreamWriter& writer) const {
+    writer.beginObject();
+    writer.key("id");
+    writer.value(id);
+    writer.key("name");
+    writer.value(name);
+    writer.key("position");
+    writer.value(position);
+    writer.endObject();
+}
 
-    // Обновляем nextId если нужно
-    if (dev.id >= nextId) {
-        nextId = dev.id + 1;
-    }
+Developer Developer::fromJson(const QJsonObject& json) {
+    Developer dev = parseJson(json);
+    reserveIds(dev.id); // Следующие разработчики получат ID больше загруженного
+    return dev;
+}
 
+Developer Developer::parseJson(const QJsonObject& json) {
+    Developer dev(json["id"].toInt()); // Создаём объект с id из JSON
+    dev.name = json["name"].toString();
+    dev.position = json["position"].toString();
     return dev;
+}
+
+void Developer::reserveIds(int maxUsedId) {
+    ids.reserve(maxUsedId);
 }
\ No newline at end of file
@@ -3,11 +3,16 @@
 
 #include <QString>
 #include <QJsonObject>
+#include "idallocator.h"
+
+class JsonStreamWriter;
 
 class Developer {
 public:
+    // ID из общего для процесса счётчика; у доски свой (Board::createDeveloper())
     Developer();
     Developer(const QString& name, const QString& position = "");
+    Developer(int id, const QString& name, const QString& position = ""); // Общий счётчик не трогается
 
     // Геттеры возвращают значения приватных полей
     int getId() const { return id; }
@@ -20,13 +25,21 @@ public:
 
     // Сериализация
     QJsonObject toJson() const; //преобразует объект Developer в JSON-объект
+    void writeJson(JsonStreamWriter& writer) const; // записывает тот же объект в поток
     static Developer fromJson(const QJsonObject& json); //создаёт объект Developer из JSON-объекта.
+    static Developer parseJson(const QJsonObject& json); // То же без сдвига общего счётчика (так читает доска)
+    static void reserveIds(int maxUsedId); // Новые разработчики получат ID больше maxUsedId
 
 private:
-    static int nextId; //статическая переменная для генерации уникальных ID
+    friend class BinaryBoardFile; // Читает записи разработчиков напрямую, как fromJson()
+    friend class Board;           // Создаёт разработчиков с ID из своего счётчика
+
+    static IdAllocator ids; // Счётчик для уникальных ID (общий для процесса, потокобезопасный)
     int id;
     QString name;
     QString position;
+
+    explicit Developer(int existingId); // ID уже известен - счётчик не трогается
 };
 
 #endif // DEVELOPER_H
\ No newline at end of file
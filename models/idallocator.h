@@ -0,0 +1,29 @@
+#ifndef IDALLOCATOR_H
+#define IDALLOCATOR_H
+
+#include <atomic>
+
+// Счётчик ID, безопасный для нескольких потоков.
+// allocate() выдаёт каждый номер ровно один раз, reserve() сдвигает счётчик
+// за уже занятый ID (например, прочитанный из файла), но никогда не назад
+class IdAllocator {
+public:
+    explicit IdAllocator(int first = 1) : next(first) {}
+
+    int allocate() { return next.fetch_add(1, std::memory_order_relaxed); }
+
+    void reserve(int usedId) {
+        int current = next.load(std::memory_order_relaxed);
+        while (usedId >= current
+               && !next.compare_exchange_weak(current, usedId + 1, std::memory_order_relaxed)) {
+        }
+    }
+
+    void reset(int first = 1) { next.store(first, std::memory_order_relaxed); }
+    int peek() const { return next.load(std::memory_order_relaxed); } // Следующий выдаваемый ID
+
+private:
+    std::atomic<int> next;
+};
+
+#endif // IDALLOCATOR_H
@@ -0,0 +1,206 @@
+#include "jsonstreamreader.h"
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonParseError>
+
+JsonStreamReader::JsonStreamReader(QIODevice* device)
+    : device(device) {
+}
+
+bool JsonStreamReader::fill() {
+    consumedBefore += buffer.size();
+    buffer = device->read(chunkSize);
+    pos = 0;
+    return !buffer.isEmpty();
+}
+
+int JsonStreamReader::peek() {
+    if (pos >= buffer.size() && !fill()) {
+        return -1;
+    }
+    return static_cast<unsigned char>(buffer[pos]);
+}
+
+int JsonStreamReader::get() {
+    int c = peek();
+    if (c >= 0) {
+        pos++;
+    }
+    return c;
+}
+
+void JsonStreamReader::skipWhitespace() {
+    for (int c = peek(); c == ' ' || c == '\n' || c == '\r' || c == '\t'; c = peek()) {
+        pos++;
+    }
+}
+
+bool JsonStreamReader::expect(char c) {
+    skipWhitespace();
+    if (get() != c) {
+        setError(QString("ожидался символ '%1' (позиция %2)").arg(QChar(c)).arg(bytesConsumed()));
+        return false;
+    }
+    return true;
+}
+
+void JsonStreamReader::setError(const QString& text) {
+    if (errorText.isEmpty()) {
+        errorText = text; // Сохраняем первую ошибку - она обычно и есть причина
+    }
+}
+
+bool JsonStreamReader::atEnd() {
+    skipWhitespace();
+    return peek() < 0;
+}
+
+bool JsonStreamReader::enterObject() {
+    if (hasError() || !expect('{')) {
+        return false;
+    }
+    firstItem.append(true);
+    return true;
+}
+
+bool JsonStreamReader::enterArray() {
+    if (hasError() || !expect('[')) {
+        return false;
+    }
+    firstItem.append(true);
+    return true;
+}
+
+bool JsonStreamReader::beforeItem(char closing) {
+    if (hasError() || firstItem.isEmpty()) {
+        return false;
+    }
+    skipWhitespace();
+    if (peek() == closing) {
+        pos++;
+        firstItem.removeLast();
+        return false;
+    }
+    if (!firstItem.last() && !expect(',')) {
+        return false;
+    }
+    firstItem.last() = false;
+    return true;
+}
+
+bool JsonStreamReader::nextKey(QString& key) {
+    if (!beforeItem('}')) {
+        return false;
+    }
+    skipWhitespace();
+    if (peek() != '"') {
+        setError(QString("ожидался ключ объекта (позиция %1)").arg(bytesConsumed()));
+        return false;
+    }
+    key = readString();
+    return expect(':');
+}
+
+bool JsonStreamReader::nextElement() {
+    return beforeItem(']');
+}
+
+QString JsonStreamReader::readString() {
+    // Ключи короткие, поэтому разбираем их через QJsonDocument вместе с экранированием
+    QByteArray raw;
+    scanString(&raw);
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson("[" + raw + "]", &parseError);
+    if (parseError.error != QJsonParseError::NoError) {
+        setError(QString("некорректная строка (позиция %1)").arg(bytesConsumed()));
+        return QString();
+    }
+    return doc.array().first().toString();
+}
+
+void JsonStreamReader::scanString(QByteArray* capture) {
+    get(); // Открывающая кавычка
+    if (capture) capture->append('"');
+    for (int c = get(); c >= 0; c = get()) {
+        if (capture) capture->append(char(c));
+        if (c == '"') {
+            return;
+        }
+        if (c == '\\') {
+            int escaped = get(); // Экранированный символ (в т.ч. кавычка) не закрывает строку
+            if (escaped < 0) break;
+            if (capture) capture->append(char(escaped));
+        }
+    }
+    setError("незакрытая строка");
+}
+
+void JsonStreamReader::scanValue(QByteArray* capture) {
+    skipWhitespace();
+    int c = peek();
+    if (c == '"') {
+        scanString(capture);
+        return;
+    }
+
+    if (c == '{' || c == '[') {
+        // Вложенный контейнер: считаем глубину, строки проходим целиком
+        int depth = 0;
+        do {
+            c = peek();
+            if (c < 0) {
+                setError("неожиданный конец данных");
+                return;
+            }
+            if (c == '"') {
+                scanString(capture);
+                continue;
+            }
+            pos++;
+            if (capture) capture->append(char(c));
+            if (c == '{' || c == '[') depth++;
+            else if (c == '}' || c == ']') depth--;
+        } while (depth > 0 && !hasError());
+        return;
+    }
+
+    // Число или литерал true/false/null - до ближайшего разделителя
+    bool any = false;
+    for (c = peek(); c >= 0 && c != ',' && c != '}' && c != ']'
+         && c != ' ' && c != '\n' && c != '\r' && c != '\t'; c = peek()) {
+        pos++;
+        any = true;
+        if (capture) capture->append(char(c));
+    }
+    if (!any) {
+        setError(QString("ожидалось значение (позиция %1)").arg(bytesConsumed()));
+    }
+}
+
+QByteArray JsonStreamReader::readRawValue() {
+    QByteArray raw;
+    if (!hasError()) {
+        scanValue(&raw);
+    }
+    return raw;
+}
+
+void JsonStreamReader::skipValue() {
+    if (!hasError()) {
+        scanValue(nullptr);
+    }
+}
+
+QJsonObject JsonStreamReader::readObject() {
+    QByteArray raw = readRawValue();
+    if (hasError()) {
+        return QJsonObject();
+    }
+    QJsonParseError parseError;
+    QJsonDocument doc = QJsonDocument::fromJson(raw, &parseError);
+    if (parseError.error != QJsonParseError::NoError || !doc.isObject()) {
+        setError(QString("ожидался объект (позиция %1)").arg(bytesConsumed()));
+        return QJsonObject();
+    }
+    return doc.object();
+}
@@ -0,0 +1,63 @@
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QJsonObject>
+#include <QString>
+#include <QVector>
+
+// Потоковый (pull) разборщик JSON. Читает устройство порциями и позволяет
+// пройти по объектам и массивам верхних уровней, не строя DOM всего документа:
+// отдельные элементы (например, одна задача) разбираются в QJsonObject по одному.
+//
+// Пример:
+//   reader.enterObject();
+//   while (reader.nextKey(key)) {
+//       if (key == "tasks" && reader.enterArray()) {
+//           while (reader.nextElement()) { QJsonObject obj = reader.readObject(); ... }
+//       } else {
+//           reader.skipValue();
+//       }
+//   }
+class JsonStreamReader {
+public:
+    explicit JsonStreamReader(QIODevice* device);
+
+    bool enterObject();           // Войти в объект ('{'); false если дальше не объект
+    bool nextKey(QString& key);   // Следующий ключ объекта; false в конце объекта ('}')
+    bool enterArray();            // Войти в массив ('['); false если дальше не массив
+    bool nextElement();           // Есть ли следующий элемент массива; false в конце (']')
+
+    QByteArray readRawValue();    // Текст следующего значения целиком, без разбора
+    QJsonObject readObject();     // Следующее значение как объект (разбор только этого значения)
+    void skipValue();             // Пропустить следующее значение
+
+    bool atEnd();                 // Дошли ли до конца данных (кроме пробелов)
+    bool hasError() const { return !errorText.isEmpty(); }
+    QString errorString() const { return errorText; }
+    qint64 bytesConsumed() const { return consumedBefore + pos; }
+
+private:
+    static const int chunkSize = 64 * 1024;
+
+    QIODevice* device;
+    QByteArray buffer;       // Текущая прочитанная порция
+    int pos = 0;             // Позиция в buffer
+    qint64 consumedBefore = 0; // Сколько байт было в уже отброшенных порциях
+    QVector<bool> firstItem; // Стек контейнеров: ждём ли первый элемент
+    QString errorText;
+
+    bool fill();             // Дочитать порцию; false в конце данных
+    int peek();              // Следующий байт без продвижения (-1 в конце)
+    int get();               // Следующий байт (-1 в конце)
+    void skipWhitespace();
+    bool expect(char c);
+    bool beforeItem(char closing); // Общая логика nextKey/nextElement
+    QString readString();
+    void scanValue(QByteArray* capture); // Пройти значение, при необходимости сохранив текст
+    void scanString(QByteArray* capture);
+    void setError(const QString& text);
+};
+
+#endif // JSONSTREAMREADER_H
@@ -0,0 +1,120 @@
+#include "jsonstreamwriter.h"
+
+JsonStreamWriter::JsonStreamWriter(QIODevice* device)
+    : device(device) {
+    buffer.reserve(flushThreshold + 4096);
+}
+
+JsonStreamWriter::~JsonStreamWriter() {
+    flush();
+}
+
+void JsonStreamWriter::beforeValue() {
+    if (afterKey) {
+        afterKey = false; // Значение пары "ключ: значение"
+        return;
+    }
+    if (!firstItem.isEmpty()) {
+        if (!firstItem.last()) {
+            buffer.append(',');
+        }
+        firstItem.last() = false;
+    }
+}
+
+void JsonStreamWriter::beginObject() {
+    beforeValue();
+    buffer.append('{');
+    firstItem.append(true);
+}
+
+void JsonStreamWriter::endObject() {
+    firstItem.removeLast();
+    buffer.append('}');
+    maybeFlush();
+}
+
+void JsonStreamWriter::beginArray() {
+    beforeValue();
+    buffer.append('[');
+    firstItem.append(true);
+}
+
+void JsonStreamWriter::endArray() {
+    firstItem.removeLast();
+    buffer.append(']');
+    maybeFlush();
+}
+
+void JsonStreamWriter::key(const QString& name) {
+    beforeValue();
+    writeString(name);
+    buffer.append(':');
+    afterKey = true;
+}
+
+void JsonStreamWriter::value(const QString& text) {
+    beforeValue();
+    writeString(text);
+}
+
+void JsonStreamWriter::value(int number) {
+    beforeValue();
+    buffer.append(QByteArray::number(number));
+}
+
+void JsonStreamWriter::value(qint64 number) {
+    beforeValue();
+    buffer.append(QByteArray::number(number));
+}
+
+void JsonStreamWriter::value(bool flag) {
+    beforeValue();
+    buffer.append(flag ? "true" : "false");
+}
+
+void JsonStreamWriter::nullValue() {
+    beforeValue();
+    buffer.append("null");
+}
+
+void JsonStreamWriter::writeString(const QString& text) {
+    static const char hex[] = "0123456789abcdef";
+    buffer.append('"');
+    const QByteArray utf8 = text.toUtf8();
+    for (char c : utf8) {
+        switch (c) {
+        case '"':  buffer.append("\\\""); break;
+        case '\\': buffer.append("\\\\"); break;
+        case '\n': buffer.append("\\n"); break;
+        case '\r': buffer.append("\\r"); break;
+        case '\t': buffer.append("\\t"); break;
+        case '\b': buffer.append("\\b"); break;
+        case '\f': buffer.append("\\f"); break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                // Прочие управляющие символы - только через \u00XX
+                buffer.append("\\u00");
+                buffer.append(hex[(c >> 4) & 0xF]);
+                buffer.append(hex[c & 0xF]);
+            } else {
+                buffer.append(c); // Многобайтовые символы UTF-8 пишем как есть
+            }
+        }
+    }
+    buffer.append('"');
+}
+
+void JsonStreamWriter::maybeFlush() {
+    if (buffer.size() >= flushThreshold) {
+        flush();
+    }
+}
+
+bool JsonStreamWriter::flush() {
+    if (!buffer.isEmpty() && !error) {
+        error = device->write(buffer) != buffer.size();
+    }
+    buffer.resize(0); // В отличие от clear() сохраняет выделенную память для следующей порции
+    return !error;
+}
@@ -0,0 +1,54 @@
+#ifndef JSONSTREAMWRITER_H
+#define JSONSTREAMWRITER_H
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QString>
+#include <QVector>
+
+// Потоковая запись JSON. Значения сразу кодируются в буфер и порциями
+// сбрасываются в устройство, поэтому дерево QJsonObject всего документа
+// не строится. Запятые между элементами расставляются автоматически.
+//
+// Пример:
+//   writer.beginObject();
+//   writer.key("tasks"); writer.beginArray();
+//   for (...) task.writeJson(writer);
+//   writer.endArray();
+//   writer.endObject();
+//   writer.flush();
+class JsonStreamWriter {
+public:
+    explicit JsonStreamWriter(QIODevice* device);
+    ~JsonStreamWriter();
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+    void key(const QString& name); // Ключ объекта; следующий вызов записывает его значение
+
+    void value(const QString& text);
+    void value(int number);
+    void value(qint64 number);
+    void value(bool flag);
+    void nullValue();
+
+    bool flush(); // Сбросить буфер в устройство; false при ошибке записи
+    bool hasError() const { return error; }
+
+private:
+    static const int flushThreshold = 64 * 1024;
+
+    QIODevice* device;
+    QByteArray buffer;
+    QVector<bool> firstItem; // Стек контейнеров: пишем ли первый элемент
+    bool afterKey = false;   // Только что записан ключ - запятая не нужна
+    bool error = false;
+
+    void beforeValue();
+    void writeString(const QString& text);
+    void maybeFlush();
+};
+
+#endif // JSONSTREAMWRITER_H
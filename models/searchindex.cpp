@@ -0,0 +1,162 @@
+#include "searchindex.h"
+#include "trace.h"
+#include <QVector>
+#include <algorithm>
+
+// Как часто (в проверенных задачах) опрашивать флаг отмены поиска
+static const int cancelCheckInterval = 1024;
+
+// Три UTF-16 символа упаковываются в одно 48-битное число
+quint64 SearchIndex::trigram(const QChar* chars) {
+    return (quint64(chars[0].unicode()) << 32) | (quint64(chars[1].unicode()) << 16) | chars[2].unicode();
+}
+
+void SearchIndex::addTrigrams(QHash<quint64, QSet<int>>& index, int taskId, const QString& folded) {
+    const QChar* data = folded.constData();
+    for (int i = 0; i + 3 <= folded.size(); i++) {
+        index[trigram(data + i)].insert(taskId);
+    }
+}
+
+void SearchIndex::removeTrigrams(QHash<quint64, QSet<int>>& index, int taskId, const QString& folded) {
+    const QChar* data = folded.constData();
+    for (int i = 0; i + 3 <= folded.size(); i++) {
+        auto it = index.find(trigram(data + i));
+        if (it == index.end()) {
+            continue; // Триграмма повторялась в тексте и уже удалена
+        }
+        it->remove(taskId);
+        if (it->isEmpty()) {
+            index.erase(it);
+        }
+    }
+}
+
+QVector<const QSet<int>*> SearchIndex::trigramSets(const QHash<quint64, QSet<int>>& index, const QString& folded) {
+    QVector<const QSet<int>*> sets;
+    for (int i = 0; i + 3 <= folded.size(); i++) {
+        auto it = index.constFind(trigram(folded.constData() + i));
+        if (it == index.constEnd()) {
+            return QVector<const QSet<int>*>(); // Какой-то триграммы нет ни в одной задаче
+        }
+        sets.append(&it.value());
+    }
+    std::sort(sets.begin(), sets.end(), [](const QSet<int>* a, const QSet<int>* b) {
+        return a->size() < b->size();
+    });
+    return sets;
+}
+
+void SearchIndex::setText(int taskId, const QString& text) {
+    remove(taskId);
+    QString folded = text.toCaseFolded();
+    addTrigrams(postings, taskId, folded);
+    documents.insert(taskId, folded);
+}
+
+void SearchIndex::remove(int taskId) {
+    auto it = documents.find(taskId);
+    if (it == documents.end()) {
+        return;
+    }
+    removeTrigrams(postings, taskId, it.value());
+    documents.erase(it);
+}
+
+void SearchIndex::addHistory(int taskId, const QString& text) {
+    addTrigrams(historyPostings, taskId, text.toCaseFolded());
+}
+
+void SearchIndex::removeHistory(int taskId, const QString& text) {
+    removeTrigrams(historyPostings, taskId, text.toCaseFolded());
+}
+
+void SearchIndex::clear() {
+    documents.clear();
+    postings.clear();
+    historyPostings.clear();
+}
+
+bool SearchIndex::matches(int taskId, const QString& query) const {
+    auto it = documents.constFind(taskId);
+    return it != documents.constEnd() && it.value().contains(query.toCaseFolded());
+}
+
+bool SearchIndex::mayMatchHistory(int taskId, const QString& query) const {
+    QString folded = query.toCaseFolded();
+    if (folded.size() < 3) {
+        return false;
+    }
+    for (int i = 0; i + 3 <= folded.size(); i++) {
+        auto it = historyPostings.constFind(trigram(folded.constData() + i));
+        if (it == historyPostings.constEnd() || !it->contains(taskId)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QSet<int> SearchIndex::search(const QString& query, const std::function<bool()>& cancelled,
+                              QSet<int>* historyCandidates) const {
+    TRACE_SCOPE("SearchIndex::search");
+    QString folded = query.toCaseFolded();
+    QSet<int> result;
+    if (historyCandidates) {
+        historyCandidates->clear();
+    }
+    int checked = 0;
+    auto isCancelled = [&]() {
+        return cancelled && ++checked % cancelCheckInterval == 0 && cancelled();
+    };
+
+    if (folded.size() < 3) {
+        // Для коротких запросов триграмм нет - проверяем все тексты
+        for (auto it = documents.constBegin(); it != documents.constEnd(); ++it) {
+            if (isCancelled()) {
+                return QSet<int>();
+            }
+            if (it.value().contains(folded)) {
+                result.insert(it.key());
+            }
+        }
+        return result;
+    }
+
+    // Кандидаты - задачи, содержащие все триграммы; затем проверка подстроки целиком
+    QVector<const QSet<int>*> sets = trigramSets(postings, folded);
+    if (!sets.isEmpty()) {
+        for (int taskId : *sets.first()) {
+            if (isCancelled()) {
+                return QSet<int>();
+            }
+            bool candidate = true;
+            for (int i = 1; i < sets.size() && candidate; i++) {
+                candidate = sets[i]->contains(taskId);
+            }
+            if (candidate && documents.value(taskId).contains(folded)) {
+                result.insert(taskId);
+            }
+        }
+    }
+
+    if (historyCandidates) {
+        QVector<const QSet<int>*> history = trigramSets(historyPostings, folded);
+        if (history.isEmpty()) {
+            return result;
+        }
+        for (int taskId : *history.first()) {
+            if (isCancelled()) {
+                historyCandidates->clear();
+                return QSet<int>();
+            }
+            bool candidate = !result.contains(taskId);
+            for (int i = 1; i < history.size() && candidate; i++) {
+                candidate = history[i]->contains(taskId);
+            }
+            if (candidate) {
+                historyCandidates->insert(taskId);
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,58 @@
+#ifndef SEARCHINDEX_H
+#define SEARCHINDEX_H
+
+#include <QHash>
+#include <QSet>
+#include <QString>
+#include <QVector>
+#include <functional>
+
+// Полнотекстовый индекс задач без учёта регистра.
+// Основной текст задачи (название и описание) хранится в свёрнутом регистре (toCaseFolded),
+// а для каждой триграммы (три подряд идущих символа) хранится множество ID задач, где она
+// встречается. Поиск пересекает множества триграмм запроса и проверяет лишь оставшихся кандидатов.
+//
+// История задач растёт без ограничений, поэтому её текст в индексе не хранится - только
+// триграммы. Задачи, у которых все триграммы запроса есть лишь в истории, search() возвращает
+// отдельно как кандидатов: их текст проверяет владелец индекса (см. Board::searchTasks()).
+// Запросы короче триграммы ищутся только по основному тексту.
+//
+// Контейнеры Qt разделяют данные при копировании, поэтому копия индекса - дешёвый
+// снимок, который можно читать в фоновом потоке, пока оригинал меняется.
+class SearchIndex {
+public:
+    void setText(int taskId, const QString& text); // Заменить основной текст задачи
+    void remove(int taskId);                       // Забыть основной текст задачи
+    // Триграммы истории: добавить фрагмент или убрать всю историю задачи
+    // (text - та же история целиком, что добавлялась по частям)
+    void addHistory(int taskId, const QString& text);
+    void removeHistory(int taskId, const QString& text);
+    void clear();
+
+    // ID задач, основной текст которых содержит query как подстроку (без учёта регистра).
+    // Пустой запрос подходит всем задачам. В historyCandidates (если передан) попадают
+    // остальные задачи, в истории которых есть все триграммы запроса. cancelled периодически
+    // опрашивается во время поиска; если он вернул true, поиск прерывается с пустым результатом
+    QSet<int> search(const QString& query, const std::function<bool()>& cancelled = {},
+                     QSet<int>* historyCandidates = nullptr) const;
+
+    // Подходит ли под запрос основной текст одной задачи (без обхода индекса)
+    bool matches(int taskId, const QString& query) const;
+    // Есть ли в истории задачи все триграммы запроса (текст истории нужно проверить отдельно)
+    bool mayMatchHistory(int taskId, const QString& query) const;
+
+    int size() const { return documents.size(); }
+
+private:
+    QHash<int, QString> documents;             // ID задачи → свёрнутый основной текст
+    QHash<quint64, QSet<int>> postings;        // Триграмма основного текста → ID задач
+    QHash<quint64, QSet<int>> historyPostings; // Триграмма истории → ID задач
+
+    static quint64 trigram(const QChar* chars);
+    static void addTrigrams(QHash<quint64, QSet<int>>& index, int taskId, const QString& folded);
+    static void removeTrigrams(QHash<quint64, QSet<int>>& index, int taskId, const QString& folded);
+    // Множества триграмм запроса, от самого маленького; пусто - какой-то триграммы нет
+    static QVector<const QSet<int>*> trigramSets(const QHash<quint64, QSet<int>>& index, const QString& folded);
+};
+
+#endif // SEARCHINDEX_H
@@ -1,89 +1,179 @@
 #include "task.h"
 #include <QJsonArray>
+#include <QStringList>
+#include <utility>
+#include "jsonstreamwriter.h"
 
-int Task::nextId = 1;
+IdAllocator Task::ids;
 
 Task::Task()
-    : id(nextId++),
+    : id(ids.allocate()),
     title(""),
     description(""),
     status(TaskStatus::Backlog), //Начальный статус - Backlog
     assignedDeveloperId(-1) { //задача не назначена
-    addHistoryEntry("Создание", "Задача создана");
+    appendHistory(TaskHistoryEntry::created(QString()));
 }
 
 Task::Task(const QString& title, const QString& description)
-    : id(nextId++),
+    : id(ids.allocate()),
     title(title),
     description(description),
     status(TaskStatus::Backlog),
     assignedDeveloperId(-1) {
-    addHistoryEntry("Создание", QString("Задача '%1' создана").arg(title));
+    appendHistory(TaskHistoryEntry::created(title));
+}
+
+Task::Task(int id, const QString& title, const QString& description)
+    : id(id),
+    title(title),
+    description(description),
+    status(TaskStatus::Backlog),
+    assignedDeveloperId(-1) {
+    appendHistory(TaskHistoryEntry::created(title));
+}
+
+Task::Task(int existingId)
+    : id(existingId),
+    status(TaskStatus::Backlog),
+    assignedDeveloperId(-1) {
+}
+
+Task::Task(const Task& other)
+    : id(other.id),
+    title(other.title),
+    description(other.description),
+    status(other.status),
+    assignedDeveloperId(other.assignedDeveloperId),
+    deadline(other.deadline),
+    history(other.history) {
+}
+
+Task::Task(Task&& other) noexcept
+    : id(other.id),
+    title(std::move(other.title)),
+    description(std::move(other.description)),
+    status(other.status),
+    assignedDeveloperId(other.assignedDeveloperId),
+    deadline(std::move(other.deadline)),
+    history(std::move(other.history)) {
+}
+
+Task& Task::operator=(const Task& other) {
+    id = other.id;
+    title = other.title;
+    description = other.description;
+    status = other.status;
+    assignedDeveloperId = other.assignedDeveloperId;
+    deadline = other.deadline;
+    history = other.history;
+    return *this;
+}
+
+Task& Task::operator=(Task&& other) noexcept {
+    id = other.id;
+    title = std::move(other.title);
+    description = std::move(other.description);
+    status = other.status;
+    assignedDeveloperId = other.assignedDeveloperId;
+    deadline = std::move(other.deadline);
+    history = std::move(other.history);
+    return *this;
 }
 
 void Task::setTitle(const QString& newTitle) {
     if (title != newTitle) {
-        addHistoryEntry("Изменение названия", QString("'%1' → '%2'").arg(title, newTitle));
+        appendHistory(TaskHistoryEntry::titleChanged(title, newTitle));
+        QString oldTitle = title;
         title = newTitle;
+        if (observer) observer->taskTitleChanged(*this, oldTitle);
     }
 }
 
 void Task::setDescription(const QString& newDescription) {
     if (description != newDescription) {
-        addHistoryEntry("Изменение описания", "Описание обновлено");
+        appendHistory(TaskHistoryEntry::descriptionChanged());
+        QString oldDescription = description;
         description = newDescription;
+        if (observer) observer->taskDescriptionChanged(*this, oldDescription);
     }
 }
 
 void Task::setStatus(TaskStatus newStatus) {
     if (status != newStatus) {
-        addHistoryEntry("Смена статуса",
-                        QString("%1 → %2").arg(statusToString(status), statusToString(newStatus)));
+        appendHistory(TaskHistoryEntry::statusChanged(int(status), int(newStatus)));
+        TaskStatus oldStatus = status;
         status = newStatus;
+        if (observer) observer->taskStatusChanged(*this, oldStatus);
     }
 }
 
 void Task::assignToDeveloper(int developerId) {
     if (assignedDeveloperId != developerId) {
-        addHistoryEntry("Назначение", QString("Назначен разработчик ID: %1").arg(developerId));
+        appendHistory(TaskHistoryEntry::assigned(developerId));
+        int oldDeveloperId = assignedDeveloperId;
         assignedDeveloperId = developerId;
+        if (observer) observer->taskAssigneeChanged(*this, oldDeveloperId);
     }
 }
 
 void Task::unassign() {
     if (assignedDeveloperId != -1) {
-        addHistoryEntry("Снятие назначения", "Разработчик снят с задачи");
+        appendHistory(TaskHistoryEntry::unassigned());
+        int oldDeveloperId = assignedDeveloperId;
         assignedDeveloperId = -1;
+        if (observer) observer->taskAssigneeChanged(*this, oldDeveloperId);
     }
 }
 
 void Task::setDeadline(const QDateTime& newDeadline) {
     if (deadline != newDeadline) {
-        QString details = newDeadline.isValid() //isValid() для проверки корректности даты
-        ? QString("Установлен дедлайн: %1").arg(newDeadline.toString("dd.MM.yyyy"))
-        : "Дедлайн удален";
-        addHistoryEntry("Изменение дедлайна", details);
+        appendHistory(TaskHistoryEntry::deadlineChanged(newDeadline)); // Невалидная дата - дедлайн удалён
+        QDateTime oldDeadline = deadline;
         deadline = newDeadline;
+        if (observer) observer->taskDeadlineChanged(*this, oldDeadline);
     }
 }
 
 int Task::daysUntilDeadline() const {
+    return daysUntilDeadline(QDateTime::currentDateTime());
+}
+
+int Task::daysUntilDeadline(const QDateTime& now) const {
     if (!deadline.isValid()) return 999;
-    return QDateTime::currentDateTime().daysTo(deadline);
+    return now.daysTo(deadline);
 }
 
 bool Task::isOverdue() const {
+    return isOverdue(QDateTime::currentDateTime());
+}
+
+bool Task::isOverdue(const QDateTime& now) const {
     if (!deadline.isValid()) return false;
-    return QDateTime::currentDateTime() > deadline && status != TaskStatus::Done; //Возвращает true если: Дедлайн установлен, текущее время позже дедлайна, задача не в статусе Done
+    return now > deadline && status != TaskStatus::Done; //Возвращает true если: Дедлайн установлен, текущее время позже дедлайна, задача не в статусе Done
 }
 
 void Task::addHistoryEntry(const QString& action, const QString& details) {
-    TaskHistoryEntry entry;
-    entry.timestamp = QDateTime::currentDateTime();
-    entry.action = action;
-    entry.details = details;
+    appendHistory(TaskHistoryEntry::custom(action, details));
+}
+
+void Task::appendHistory(const TaskHistoryEntry& entry) {
     history.append(entry);
-} 
+    if (observer) observer->taskHistoryAppended(*this, entry);
+}
+
+QString Task::searchableText() const {
+    return title + '\n' + description;
+}
+
+QString Task::historyText() const {
+    QStringList parts;
+    parts.reserve(history.size());
+    for (const TaskHistoryEntry& entry : history) {
+        parts << entry.getDetails();
+    }
+    return parts.join('\n');
+}
 
 QJsonObject Task::toJson() const {
     QJsonObject json; //Создает JSON-объект со всеми данными задачи
@@ -103,9 +193,39 @@ QJsonObject Task::toJson() const {
     return json; //Сохраняет всю историю как массив JSON-объектов
 }
 
+void Task::writeJson(JsonStreamWriter& writer) const {
+    // Поля и формат те же, что в toJson()
+    writer.beginObject();
+    writer.key("id");
+    writer.value(id);
+    writer.key("title");
+    writer.value(title);
+    writer.key("description");
+    writer.value(description);
+    writer.key("status");
+    writer.value(statusToString(status));
+    writer.key("assignedDeveloperId");
+    writer.value(assignedDeveloperId);
+    writer.key("deadline");
+    writer.value(deadline.isValid() ? deadline.toString(Qt::ISODate) : QString());
+
+    writer.key("history");
+    writer.beginArray();
+    for (const TaskHistoryEntry& entry : history) {
+        entry.writeJson(writer);
+    }
+    writer.endArray();
+    writer.endObject();
+}
+
 Task Task::fromJson(const QJsonObject& json) {
-    Task task; // Создает временный объект Task с помощью конструктора 
-    task.id = json["id"].toInt();
+    Task task = parseJson(json);
+    reserveIds(task.id); //Следующие задачи получат ID больше загруженного
+    return task;
+}
+
+Task Task::parseJson(const QJsonObject& json) {
+    Task task(json["id"].toInt()); // Конструктор без выдачи нового ID и записи "создана"
     task.title = json["title"].toString();
     task.description = json["description"].toString();
     task.status = stringToStatus(json["status"].toString());
@@ -116,19 +236,18 @@ Task Task::fromJson(const QJsonObject& json) {
         task.deadline = QDateTime::fromString(deadlineStr, Qt::ISODate);
     }
 
-    task.history.clear();
     QJsonArray historyArray = json["history"].toArray(); //Восстанавливает историю из JSON-массива
     for (const QJsonValue& value : historyArray) {
         task.history.append(TaskHistoryEntry::fromJson(value.toObject()));
     }
 
-    if (task.id >= nextId) { 
-        nextId = task.id + 1; //Обновляет статический nextId если загруженный ID больше текущего
-    }
-
     return task;
 }
 
+void Task::reserveIds(int maxUsedId) {
+    ids.reserve(maxUsedId);
+}
+
 QString Task::statusToString(TaskStatus status) { //TaskStatus (enum class) автоматически конвертируется в int
     switch (status) { //switch - работает только с целыми типами (int, char, enum)
     case TaskStatus::Backlog:    return "Backlog";
@@ -148,20 +267,3 @@ TaskStatus Task::stringToStatus(const QString& str) { //QString (объект с
     if (str == "Done")       return TaskStatus::Done;
     return TaskStatus::Backlog;
 }
-
-// Сериализация объекта TaskHistoryEntry в формат JSON
-QJsonObject TaskHistoryEntry::toJson() const {
-    QJsonObject json; // Создаем пустой JSON-объект
-    json["timestamp"] = timestamp.toString(Qt::ISODate);
-    json["action"] = action;
-    json["details"] = details;
-    return json; // Возвращаем заполненный JSON-объект
-}
-// Десериализация JSON-объекта обратно в объект TaskHistoryEntry
-TaskHistoryEntry TaskHistoryEntry::fromJson(const QJsonObject& json) {
-    TaskHistoryEntry entry; // Создаем новый объект записи истории
-    entry.timestamp = QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate); //Все поля сохраняются как строки
-    entry.action = json["action"].toString(); 
-    entry.details = json["details"].toString();
-    return entry; // Возвращаем восстановленный объект записи истории
-}
\ No newline at end of file
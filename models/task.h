@@ -5,6 +5,8 @@
 #include <QJsonObject>
 #include <QDateTime>
 #include <QList>
+#include "taskhistory.h"
+#include "idallocator.h"
 
 // Статусы задачи
 enum class TaskStatus {
@@ -15,20 +17,39 @@ enum class TaskStatus {
     Done        // СДЕЛАНО!
 };
 
-// Запись в истории задачи
-struct TaskHistoryEntry {
-    QDateTime timestamp;
-    QString action;
-    QString details;
+class JsonStreamWriter;
 
-    QJsonObject toJson() const;
-    static TaskHistoryEntry fromJson(const QJsonObject& json);
+class Task;
+
+// Наблюдатель за изменениями задачи. Доска подписывается на свои задачи
+// и по этим уведомлениям поддерживает индексы в актуальном состоянии.
+class TaskObserver {
+public:
+    virtual ~TaskObserver() = default;
+    virtual void taskTitleChanged(const Task& /*task*/, const QString& /*oldTitle*/) {}
+    virtual void taskDescriptionChanged(const Task& /*task*/, const QString& /*oldDescription*/) {}
+    virtual void taskStatusChanged(const Task& /*task*/, TaskStatus /*oldStatus*/) {}
+    virtual void taskAssigneeChanged(const Task& /*task*/, int /*oldDeveloperId*/) {}
+    virtual void taskDeadlineChanged(const Task& /*task*/, const QDateTime& /*oldDeadline*/) {}
+    virtual void taskHistoryAppended(const Task& /*task*/, const TaskHistoryEntry& /*entry*/) {}
 };
 
 class Task {
 public:
+    // ID из общего для процесса счётчика - для задач вне доски. Доска ведёт свой счётчик:
+    // задачу для неё создавайте Board::createTask() или с ID из Board::allocateTaskId(),
+    // иначе ID может совпасть с задачей доски (addTask() с тем же ID заменяет задачу)
     Task();
     Task(const QString& title, const QString& description = "");
+    Task(int id, const QString& title, const QString& description = ""); // Общий счётчик не трогается
+
+    // Копия и перемещение переносят данные задачи, но не наблюдателя: он подписан
+    // на конкретный объект (задачу в списке доски), а копия может пережить доску.
+    // Присваивание сохраняет наблюдателя задачи, которой присваивают
+    Task(const Task& other);
+    Task(Task&& other) noexcept;
+    Task& operator=(const Task& other);
+    Task& operator=(Task&& other) noexcept;
 
     // Геттеры
     int getId() const { return id; }
@@ -37,7 +58,7 @@ public:
     TaskStatus getStatus() const { return status; }
     int getAssignedDeveloperId() const { return assignedDeveloperId; }
     QDateTime getDeadline() const { return deadline; }
-    QList<TaskHistoryEntry> getHistory() const { return history; }
+    const TaskHistory& getHistory() const { return history; } // Без копирования; записи из файла читаются по требованию
 
     // Сеттеры
     void setTitle(const QString& newTitle); // Изменить заголовок
@@ -51,28 +72,51 @@ public:
     bool isAssigned() const { return assignedDeveloperId != -1; }
     bool hasDeadline() const { return deadline.isValid(); }
     int daysUntilDeadline() const;
+    int daysUntilDeadline(const QDateTime& now) const; // Относительно заданного момента
     bool isOverdue() const; // Просрочена ли задача?
+    bool isOverdue(const QDateTime& now) const;
+
+    // Наблюдатель (nullptr - уведомления не отправляются)
+    void setObserver(TaskObserver* newObserver) { observer = newObserver; }
+
+    // Текст для полнотекстового поиска: название и описание; детали истории - отдельно
+    // (их читают из файла только при индексации и проверке кандидатов поиска)
+    QString searchableText() const;
+    QString historyText() const;
 
     // История
     void addHistoryEntry(const QString& action, const QString& details); // Добавить запись в историю
 
     // Сериализация
     QJsonObject toJson() const; // Конвертировать задачу в JSON
+    void writeJson(JsonStreamWriter& writer) const; // То же, но сразу в поток (для сохранения доски)
     static Task fromJson(const QJsonObject& json);// Создать задачу из JSON
+    // То же без обновления общего счётчика ID (безопасно из нескольких потоков). Так читает
+    // задачи доска: её собственный счётчик сдвигает Board::addTask()
+    static Task parseJson(const QJsonObject& json);
+    static void reserveIds(int maxUsedId); // Новые задачи получат ID больше maxUsedId
 
     // Конвертация статуса в строку и обратно
     static QString statusToString(TaskStatus status);
     static TaskStatus stringToStatus(const QString& str);
 
 private:
-    static int nextId;
+    friend class BinaryBoardFile; // Читает записи задач напрямую, как fromJson()
+    friend class BoardJournal;    // Проигрывает изменения полей без новых записей истории
+    friend class Board;           // Создаёт задачи с ID из своего счётчика (createTask)
+
+    static IdAllocator ids; // ID задач, созданных конструктором (общие для процесса)
     int id;
     QString title;
     QString description;
     TaskStatus status;
     int assignedDeveloperId; // -1 если не назначена
     QDateTime deadline;
-    QList<TaskHistoryEntry> history;
+    TaskHistory history;
+    TaskObserver* observer = nullptr;
+
+    explicit Task(int existingId); // Для загрузки: счётчик ID и история не трогаются
+    void appendHistory(const TaskHistoryEntry& entry); // Добавить запись и уведомить наблюдателя
 };
 
 #endif // TASK_H
\ No newline at end of file
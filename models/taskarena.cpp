@@ -0,0 +1,70 @@
+#include "taskarena.h"
+#include <new>
+
+TaskArena::~TaskArena() {
+    Q_ASSERT(used == 0); // Задачи уничтожает владелец
+    clear();
+}
+
+Task* TaskArena::create(const Task& task) {
+    Slot* slot = takeSlot();
+    used++;
+    return new (slot->storage) Task(task);
+}
+
+void TaskArena::destroy(Task* task) {
+    if (!task) {
+        return;
+    }
+    task->~Task();
+    // Ячейка начинается с объекта задачи, так что адрес задачи - адрес ячейки
+    Slot* slot = reinterpret_cast<Slot*>(task);
+    slot->nextFree = freeList;
+    freeList = slot;
+    used--;
+}
+
+void TaskArena::reserve(int count) {
+    int available = totalSlots - used;
+    if (count > available) {
+        addBlock(qMax(count - available, minBlockSlots));
+    }
+}
+
+void TaskArena::clear() {
+    for (const Block& block : blocks) {
+        delete[] block.slots;
+    }
+    blocks.clear();
+    freeList = nullptr;
+    blockUsed = 0;
+    used = 0;
+    totalSlots = 0;
+}
+
+void TaskArena::addBlock(int count) {
+    // Невыданный остаток прежнего блока не теряется - переносим его в список свободных
+    if (!blocks.isEmpty()) {
+        const Block& last = blocks.last();
+        for (int i = blockUsed; i < last.count; i++) {
+            last.slots[i].nextFree = freeList;
+            freeList = &last.slots[i];
+        }
+    }
+    blocks.append(Block{new Slot[count], count});
+    blockUsed = 0;
+    totalSlots += count;
+}
+
+TaskArena::Slot* TaskArena::takeSlot() {
+    if (freeList) {
+        Slot* slot = freeList;
+        freeList = slot->nextFree;
+        return slot;
+    }
+    if (blocks.isEmpty() || blockUsed == blocks.last().count) {
+        // Блоки растут вместе с доской, так что их число - логарифм от числа задач
+        addBlock(qBound(minBlockSlots, totalSlots, maxBlockSlots));
+    }
+    return &blocks.last().slots[blockUsed++];
+}
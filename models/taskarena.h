@@ -0,0 +1,88 @@
+#ifndef TASKARENA_H
+#define TASKARENA_H
+
+#include <QVector>
+#include "task.h"
+
+// Хранилище задач доски с постоянными адресами.
+// Память выделяется блоками сразу на много задач, и объект Task не перемещается,
+// пока его не уничтожат через destroy(). Освободившиеся ячейки образуют список
+// свободных и занимаются повторно при следующем create().
+// Арена не знает, какие ячейки заняты: уничтожить задачи до clear() или
+// разрушения арены должен владелец (Board)
+class TaskArena {
+public:
+    TaskArena() = default;
+    ~TaskArena();
+    TaskArena(const TaskArena&) = delete;
+    TaskArena& operator=(const TaskArena&) = delete;
+
+    Task* create(const Task& task); // Копия задачи в свободной ячейке
+    void destroy(Task* task);       // Ячейка возвращается в список свободных
+    void reserve(int count);        // Место ещё под count задач одним блоком
+    void clear();                   // Освободить все блоки (задачи уже уничтожены)
+
+    int size() const { return used; }
+    int capacity() const { return totalSlots; }
+    int blockCount() const { return blocks.size(); }
+
+private:
+    // Ячейка либо содержит задачу, либо хранит ссылку на следующую свободную
+    union Slot {
+        Slot* nextFree;
+        alignas(Task) unsigned char storage[sizeof(Task)];
+    };
+
+    struct Block {
+        Slot* slots;
+        int count;
+    };
+
+    static constexpr int minBlockSlots = 256;
+    static constexpr int maxBlockSlots = 65536;
+
+    QVector<Block> blocks;
+    Slot* freeList = nullptr;
+    int blockUsed = 0;  // Сколько ячеек последнего блока уже выдавалось
+    int used = 0;
+    int totalSlots = 0;
+
+    void addBlock(int count);
+    Slot* takeSlot();
+};
+
+// Список задач доски без копирования: обход по указателям из плотного массива,
+// но элементы выдаются как ссылки на Task (range-for, operator[], size())
+template <typename T>
+class TaskRange {
+public:
+    class const_iterator {
+    public:
+        explicit const_iterator(Task* const* item) : item(item) {}
+        T& operator*() const { return **item; }
+        T* operator->() const { return *item; }
+        const_iterator& operator++() { ++item; return *this; }
+        bool operator==(const const_iterator& other) const { return item == other.item; }
+        bool operator!=(const const_iterator& other) const { return item != other.item; }
+
+    private:
+        Task* const* item;
+    };
+
+    explicit TaskRange(const QVector<Task*>& items) : items(&items) {}
+
+    int size() const { return items->size(); }
+    int count() const { return items->size(); }
+    bool isEmpty() const { return items->isEmpty(); }
+    T& operator[](int index) const { return *items->at(index); }
+    T& at(int index) const { return *items->at(index); }
+    T& first() const { return *items->first(); }
+    T& last() const { return *items->last(); }
+    const_iterator begin() const { return const_iterator(items->constData()); }
+    const_iterator end() const { return const_iterator(items->constData() + items->size()); }
+
+private:
+    const QVector<Task*>* items;
+};
+
+#endif // TASKARENA_H
@@ -0,0 +1,253 @@
+#include "taskhistory.h"
+#include "jsonstreamwriter.h"
+#include "task.h"
+#include <QStringList>
+
+TaskHistory::TaskHistory(std::shared_ptr<const HistorySource> source, int key, int count)
+    : source(count > 0 ? std::move(source) : nullptr),
+    sourceKey(key),
+    storedCount(count > 0 ? count : 0) {
+}
+
+TaskHistoryEntry TaskHistory::at(int index) const {
+    if (index < 0 || index >= size()) {
+        return TaskHistoryEntry();
+    }
+    if (index < storedCount) {
+        return source->historyEntry(sourceKey, index); // Одна запись, без чтения всего блока
+    }
+    return recent[index - storedCount];
+}
+
+QList<TaskHistoryEntry> TaskHistory::toList() const {
+    if (!source) {
+        return recent; // Неявное разделение - без копирования записей
+    }
+    QList<TaskHistoryEntry> entries = source->historyEntries(sourceKey);
+    entries.append(recent);
+    return entries;
+}
+
+void TaskHistory::append(const TaskHistoryEntry& entry) {
+    recent.append(entry); // Источник не трогаем: новые записи просто идут после сохранённых
+}
+
+void TaskHistory::clear() {
+    source.reset();
+    sourceKey = -1;
+    storedCount = 0;
+    recent.clear();
+}
+
+void TaskHistory::materialize() const {
+    if (!source) {
+        return;
+    }
+    recent = toList();
+    source.reset();
+    sourceKey = -1;
+    storedCount = 0;
+}
+
+// Время и код со значением - по 8 байт, строки - ещё 8 (указатель)
+static_assert(sizeof(TaskHistoryEntry) <= 3 * sizeof(qint64), "запись истории должна оставаться компактной");
+
+namespace {
+
+// Тексты действий стандартных записей (в том же порядке, что HistoryAction)
+const char* const actionNames[] = {
+    "",
+    "Создание",
+    "Изменение названия",
+    "Изменение описания",
+    "Смена статуса",
+    "Назначение",
+    "Снятие назначения",
+    "Изменение дедлайна",
+    "Изменение дедлайна"
+};
+
+const char* const deadlineFormat = "dd.MM.yyyy";
+
+} // namespace
+
+TaskHistoryEntry TaskHistoryEntry::make(HistoryAction code) {
+    TaskHistoryEntry entry;
+    entry.timestampMs = QDateTime::currentMSecsSinceEpoch();
+    entry.setActionCode(code);
+    return entry;
+}
+
+void TaskHistoryEntry::setTexts(const QString& text, const QString& text2) {
+    if (text.isNull() && text2.isNull()) {
+        texts.reset(); // Без строк - без отдельного блока памяти
+        return;
+    }
+    texts = new Texts;
+    texts->text = text;
+    texts->text2 = text2;
+}
+
+TaskHistoryEntry TaskHistoryEntry::created(const QString& title) {
+    TaskHistoryEntry entry = make(HistoryAction::Created);
+    entry.setTexts(title);
+    entry.setValue(title.isNull() ? 0 : 1); // Задача без названия (конструктор по умолчанию)
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::titleChanged(const QString& oldTitle, const QString& newTitle) {
+    TaskHistoryEntry entry = make(HistoryAction::TitleChanged);
+    entry.setTexts(oldTitle, newTitle);
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::descriptionChanged() {
+    return make(HistoryAction::DescriptionChanged);
+}
+
+TaskHistoryEntry TaskHistoryEntry::statusChanged(int oldStatus, int newStatus) {
+    TaskHistoryEntry entry = make(HistoryAction::StatusChanged);
+    entry.setValue(oldStatus * 16 + newStatus);
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::assigned(int developerId) {
+    TaskHistoryEntry entry = make(HistoryAction::Assigned);
+    entry.setValue(developerId);
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::unassigned() {
+    return make(HistoryAction::Unassigned);
+}
+
+TaskHistoryEntry TaskHistoryEntry::deadlineChanged(const QDateTime& newDeadline) {
+    if (!newDeadline.isValid()) {
+        return make(HistoryAction::DeadlineRemoved);
+    }
+    TaskHistoryEntry entry = make(HistoryAction::DeadlineSet);
+    entry.setValue(newDeadline.toMSecsSinceEpoch());
+    return entry;
+}
+
+TaskHistoryEntry TaskHistoryEntry::custom(const QString& action, const QString& details) {
+    TaskHistoryEntry entry = make(HistoryAction::Custom);
+    entry.setTexts(details, action);
+    return entry;
+}
+
+QString TaskHistoryEntry::getAction() const {
+    const HistoryAction code = getActionCode();
+    if (code == HistoryAction::Custom) {
+        return text2();
+    }
+    return QString::fromUtf8(actionNames[int(code)]);
+}
+
+QString TaskHistoryEntry::getDetails() const {
+    const qint64 value = this->value();
+    switch (getActionCode()) {
+    case HistoryAction::Custom:
+        return text();
+    case HistoryAction::Created:
+        return value == 0 ? QString("Задача создана") : QString("Задача '%1' создана").arg(text());
+    case HistoryAction::TitleChanged:
+        return QString("'%1' → '%2'").arg(text(), text2());
+    case HistoryAction::DescriptionChanged:
+        return "Описание обновлено";
+    case HistoryAction::StatusChanged:
+        return QString("%1 → %2").arg(Task::statusToString(TaskStatus(value / 16)),
+                                      Task::statusToString(TaskStatus(value % 16)));
+    case HistoryAction::Assigned:
+        return QString("Назначен разработчик ID: %1").arg(value);
+    case HistoryAction::Unassigned:
+        return "Разработчик снят с задачи";
+    case HistoryAction::DeadlineSet:
+        return QString("Установлен дедлайн: %1").arg(QDateTime::fromMSecsSinceEpoch(value).toString(deadlineFormat));
+    case HistoryAction::DeadlineRemoved:
+        return "Дедлайн удален";
+    }
+    return text();
+}
+
+TaskHistoryEntry TaskHistoryEntry::fromText(qint64 timestampMs, const QString& action, const QString& details) {
+    TaskHistoryEntry entry;
+    entry.timestampMs = timestampMs;
+
+    // Разбираем подробности стандартного действия обратно в значения
+    if (action == actionNames[int(HistoryAction::Created)]) {
+        entry.setActionCode(HistoryAction::Created);
+        if (details.startsWith("Задача '") && details.endsWith("' создана")) {
+            entry.setTexts(details.mid(8, details.size() - 8 - 9));
+            entry.setValue(1);
+        }
+    } else if (action == actionNames[int(HistoryAction::TitleChanged)]) {
+        int arrow = details.indexOf("' → '");
+        if (details.startsWith('\'') && details.endsWith('\'') && arrow > 0) {
+            entry.setActionCode(HistoryAction::TitleChanged);
+            entry.setTexts(details.mid(1, arrow - 1), details.mid(arrow + 5, details.size() - arrow - 6));
+        }
+    } else if (action == actionNames[int(HistoryAction::DescriptionChanged)]) {
+        entry.setActionCode(HistoryAction::DescriptionChanged);
+    } else if (action == actionNames[int(HistoryAction::StatusChanged)]) {
+        QStringList parts = details.split(" → ");
+        if (parts.size() == 2) {
+            entry.setActionCode(HistoryAction::StatusChanged);
+            entry.setValue(int(Task::stringToStatus(parts[0])) * 16 + int(Task::stringToStatus(parts[1])));
+        }
+    } else if (action == actionNames[int(HistoryAction::Assigned)]) {
+        bool ok = false;
+        int developerId = details.mid(details.lastIndexOf(' ') + 1).toInt(&ok);
+        if (ok) {
+            entry.setActionCode(HistoryAction::Assigned);
+            entry.setValue(developerId);
+        }
+    } else if (action == actionNames[int(HistoryAction::Unassigned)]) {
+        entry.setActionCode(HistoryAction::Unassigned);
+    } else if (action == actionNames[int(HistoryAction::DeadlineSet)]) {
+        QDate date = QDate::fromString(details.mid(details.lastIndexOf(' ') + 1), deadlineFormat);
+        if (date.isValid()) {
+            entry.setActionCode(HistoryAction::DeadlineSet);
+            entry.setValue(QDateTime(date, QTime(0, 0)).toMSecsSinceEpoch());
+        } else {
+            entry.setActionCode(HistoryAction::DeadlineRemoved);
+        }
+    }
+
+    // Если текст не восстанавливается из значений один в один - храним его как есть
+    if (entry.getActionCode() != HistoryAction::Custom && entry.getDetails() != details) {
+        entry = TaskHistoryEntry();
+        entry.timestampMs = timestampMs;
+    }
+    if (entry.getActionCode() == HistoryAction::Custom) {
+        entry.setTexts(details, action);
+    }
+    return entry;
+}
+
+// Сериализация объекта TaskHistoryEntry в формат JSON
+QJsonObject TaskHistoryEntry::toJson() const {
+    QJsonObject json; // Создаем пустой JSON-объект
+    json["timestamp"] = getTimestamp().toString(Qt::ISODate);
+    json["action"] = getAction();
+    json["details"] = getDetails(); // Формат тот же, что до компактного хранения
+    return json; // Возвращаем заполненный JSON-объект
+}
+
+void TaskHistoryEntry::writeJson(JsonStreamWriter& writer) const {
+    writer.beginObject();
+    writer.key("timestamp");
+    writer.value(getTimestamp().toString(Qt::ISODate));
+    writer.key("action");
+    writer.value(getAction());
+    writer.key("details");
+    writer.value(getDetails());
+    writer.endObject();
+}
+
+// Десериализация JSON-объекта обратно в объект TaskHistoryEntry
+TaskHistoryEntry TaskHistoryEntry::fromJson(const QJsonObject& json) {
+    QDateTime timestamp = QDateTime::fromString(json["timestamp"].toString(), Qt::ISODate); //Все поля сохраняются как строки
+    return TaskHistoryEntry::fromText(timestamp.isValid() ? timestamp.toMSecsSinceEpoch() : noTimestamp,
+                                      json["action"].toString(), json["details"].toString());
+}
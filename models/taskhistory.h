@@ -0,0 +1,153 @@
+#ifndef TASKHISTORY_H
+#define TASKHISTORY_H
+
+#include <QString>
+#include <QJsonObject>
+#include <QDateTime>
+#include <QList>
+#include <QSharedData>
+#include <limits>
+#include <memory>
+
+class JsonStreamWriter;
+
+// Вид записи истории. Для стандартных действий хранится только код и значения,
+// а текст действия и подробностей строится при показе
+enum class HistoryAction : quint8 {
+    Custom,             // Произвольная запись: текст действия и подробностей хранится как есть
+    Created,            // text - название задачи, value: 0 - задача создана без названия
+    TitleChanged,       // text - старое название, text2 - новое
+    DescriptionChanged,
+    StatusChanged,      // value: старый статус * 16 + новый
+    Assigned,           // value - ID разработчика
+    Unassigned,
+    DeadlineSet,        // value - дедлайн, мс от эпохи
+    DeadlineRemoved
+};
+
+// Запись в истории задачи. Компактна: время в мс, код действия со значением в одном
+// числе и указатель на строки. Строки есть только у названий и произвольных записей;
+// остальные записи (статус, назначение, дедлайн) занимают 24 байта
+class TaskHistoryEntry {
+public:
+    TaskHistoryEntry() = default;
+
+    // Записи для стандартных действий с текущим временем
+    static TaskHistoryEntry created(const QString& title);
+    static TaskHistoryEntry titleChanged(const QString& oldTitle, const QString& newTitle);
+    static TaskHistoryEntry descriptionChanged();
+    static TaskHistoryEntry statusChanged(int oldStatus, int newStatus);
+    static TaskHistoryEntry assigned(int developerId);
+    static TaskHistoryEntry unassigned();
+    static TaskHistoryEntry deadlineChanged(const QDateTime& newDeadline);
+    static TaskHistoryEntry custom(const QString& action, const QString& details);
+
+    // Запись по тексту действия и подробностей (как в JSON): стандартные
+    // действия распознаются и хранятся компактно, остальные - как Custom
+    static TaskHistoryEntry fromText(qint64 timestampMs, const QString& action, const QString& details);
+
+    // Время записи не известно (в JSON пустая строка) - getTimestamp() вернёт невалидную дату
+    static constexpr qint64 noTimestamp = std::numeric_limits<qint64>::min();
+
+    qint64 getTimestampMs() const { return timestampMs; }
+    QDateTime getTimestamp() const {
+        return timestampMs == noTimestamp ? QDateTime() : QDateTime::fromMSecsSinceEpoch(timestampMs);
+    }
+    void setTimestampMs(qint64 ms) { timestampMs = ms; }
+    HistoryAction getActionCode() const { return HistoryAction(packed >> valueBits); }
+    QString getAction() const;  // Текст действия ("Смена статуса")
+    QString getDetails() const; // Подробности ("Backlog → Done"), строятся при вызове
+
+    QJsonObject toJson() const;
+    void writeJson(JsonStreamWriter& writer) const; // Потоковая запись без QJsonObject
+    static TaskHistoryEntry fromJson(const QJsonObject& json);
+
+private:
+    friend class BinaryBoardFile; // Пишет и читает поля записи через закрытые методы
+
+    // Строки записи хранятся отдельно и разделяются её копиями
+    struct Texts : QSharedData {
+        QString text;  // См. HistoryAction; у Custom - подробности
+        QString text2; // См. HistoryAction; у Custom - действие
+    };
+
+    // packed: старшие 8 бит - код действия, младшие 56 - значение со знаком
+    // (дедлайн в мс помещается с запасом на сотни тысяч лет)
+    static constexpr int valueBits = 56;
+    static constexpr quint64 valueMask = (quint64(1) << valueBits) - 1;
+
+    qint64 timestampMs = noTimestamp;
+    quint64 packed = 0; // Custom, значение 0
+    QExplicitlySharedDataPointer<Texts> texts;
+
+    static TaskHistoryEntry make(HistoryAction code);
+    void setActionCode(HistoryAction code) { packed = (quint64(code) << valueBits) | (packed & valueMask); }
+    qint64 value() const { return qint64(packed << (64 - valueBits)) >> (64 - valueBits); }
+    void setValue(qint64 value) { packed = (packed & ~valueMask) | (quint64(value) & valueMask); }
+    QString text() const { return texts ? texts->text : QString(); }
+    QString text2() const { return texts ? texts->text2 : QString(); }
+    void setTexts(const QString& text, const QString& text2 = QString());
+};
+
+// Источник сохранённой истории (например, открытый файл доски).
+// key - номер блока истории в источнике, его выдаёт сам источник
+class HistorySource {
+public:
+    virtual ~HistorySource() = default;
+    virtual TaskHistoryEntry historyEntry(int key, int index) const = 0;
+    virtual QList<TaskHistoryEntry> historyEntries(int key) const = 0;
+};
+
+// История задачи. Записи, загруженные из файла, остаются в источнике и читаются
+// по требованию, а в памяти хранятся только записи, добавленные после загрузки.
+// Копирование дешёвое: копируется ссылка на источник и неявно разделяемый список.
+class TaskHistory {
+public:
+    // Итератор для range-for; разыменование возвращает запись по значению
+    class const_iterator {
+    public:
+        const_iterator(const TaskHistory* history, int index) : history(history), index(index) {}
+        TaskHistoryEntry operator*() const { return history->at(index); }
+        const_iterator& operator++() { ++index; return *this; }
+        bool operator!=(const const_iterator& other) const { return index != other.index; }
+        bool operator==(const const_iterator& other) const { return index == other.index; }
+
+    private:
+        const TaskHistory* history;
+        int index;
+    };
+
+    TaskHistory() = default;
+    TaskHistory(std::shared_ptr<const HistorySource> source, int key, int count);
+
+    int size() const { return storedCount + recent.size(); }
+    int count() const { return size(); }
+    bool isEmpty() const { return size() == 0; }
+    bool isLazy() const { return source != nullptr; } // Часть записей ещё в источнике
+
+    TaskHistoryEntry at(int index) const;
+    TaskHistoryEntry operator[](int index) const { return at(index); }
+    TaskHistoryEntry first() const { return at(0); }
+    TaskHistoryEntry last() const { return at(size() - 1); }
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    QList<TaskHistoryEntry> toList() const; // Все записи в памяти (прочитать источник целиком)
+    operator QList<TaskHistoryEntry>() const { return toList(); }
+
+    void append(const TaskHistoryEntry& entry);
+    void clear();
+
+    // Перенести сохранённые записи в память и отпустить источник
+    // (нужно, например, перед перезаписью файла, из которого они читаются)
+    void materialize() const;
+
+private:
+    // mutable: materialize() меняет только способ хранения, не содержимое
+    mutable std::shared_ptr<const HistorySource> source;
+    mutable int sourceKey = -1;
+    mutable int storedCount = 0;            // Сколько записей лежит в источнике
+    mutable QList<TaskHistoryEntry> recent; // Записи после сохранённых
+};
+
+#endif // TASKHISTORY_H
@@ -0,0 +1,125 @@
+#include "trace.h"
+#include "jsonstreamwriter.h"
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QSaveFile>
+#include <QThread>
+#include <QVector>
+#include <atomic>
+
+namespace {
+
+struct TraceEvent {
+    const char* name;
+    const char* category;
+    qint64 startUs;
+    qint64 durationUs;
+    quintptr threadId;
+};
+
+std::atomic<bool> enabled{false};
+QMutex eventsMutex; // Замеры пишутся из потоков загрузки, поиска и автосохранения
+QVector<TraceEvent> events;
+
+const char* const environmentVariable = "SCRUM_BOARD_TRACE";
+
+QElapsedTimer& clock() {
+    static QElapsedTimer timer = [] {
+        QElapsedTimer started;
+        started.start();
+        return started;
+    }();
+    return timer;
+}
+
+} // namespace
+
+void Trace::setEnabled(bool value) {
+    clock(); // Шкала времени начинается не позже включения
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+bool Trace::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+qint64 Trace::nowUs() {
+    return clock().nsecsElapsed() / 1000;
+}
+
+void Trace::record(const char* name, const char* category, qint64 startUs, qint64 durationUs) {
+    const quintptr threadId = quintptr(QThread::currentThreadId());
+    QMutexLocker locker(&eventsMutex);
+    events.append(TraceEvent{name, category, startUs, durationUs, threadId});
+}
+
+int Trace::eventCount() {
+    QMutexLocker locker(&eventsMutex);
+    return events.size();
+}
+
+void Trace::clear() {
+    QMutexLocker locker(&eventsMutex);
+    events.clear();
+}
+
+bool Trace::writeChromeTrace(const QString& filename) {
+    QVector<TraceEvent> copy;
+    {
+        QMutexLocker locker(&eventsMutex);
+        copy = events;
+    }
+
+    QSaveFile file(filename);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+    // Формат: {"traceEvents": [{"name", "cat", "ph": "X", "ts", "dur", "pid", "tid"}, ...]}
+    const qint64 pid = QCoreApplication::applicationPid();
+    JsonStreamWriter writer(&file);
+    writer.beginObject();
+    writer.key("traceEvents");
+    writer.beginArray();
+    for (const TraceEvent& event : copy) {
+        writer.beginObject();
+        writer.key("name");
+        writer.value(QString::fromUtf8(event.name));
+        writer.key("cat");
+        writer.value(QString::fromUtf8(event.category));
+        writer.key("ph");
+        writer.value(QString("X")); // Завершённый интервал
+        writer.key("ts");
+        writer.value(event.startUs);
+        writer.key("dur");
+        writer.value(event.durationUs);
+        writer.key("pid");
+        writer.value(pid);
+        writer.key("tid");
+        writer.value(qint64(event.threadId));
+        writer.endObject();
+    }
+    writer.endArray();
+    writer.key("displayTimeUnit");
+    writer.value(QString("ms"));
+    writer.endObject();
+    if (!writer.flush()) {
+        file.cancelWriting();
+        return false;
+    }
+    return file.commit();
+}
+
+void Trace::startFromEnvironment() {
+#ifdef SCRUM_BOARD_TRACING
+    if (!qEnvironmentVariableIsEmpty(environmentVariable)) {
+        setEnabled(true);
+    }
+#endif
+}
+
+void Trace::finish() {
+    if (isEnabled()) {
+        writeChromeTrace(qEnvironmentVariable(environmentVariable));
+    }
+}
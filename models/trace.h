@@ -0,0 +1,72 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <QString>
+
+// Лёгкая трассировка горячих путей (обновление доски, загрузка, сохранение, поиск).
+// TRACE_SCOPE("имя") замеряет время до конца блока. Макросы компилируются, только
+// если задан SCRUM_BOARD_TRACING (опция CMake ENABLE_TRACING); иначе они пустые и ничего не стоят.
+// Замеры копятся в памяти, пока трассировка включена (Trace::setEnabled), и выгружаются
+// в формате Chrome trace event (chrome://tracing, ui.perfetto.dev) через writeChromeTrace().
+//
+// Приложение включает трассировку переменной окружения SCRUM_BOARD_TRACE=<файл.json>
+// и записывает файл при выходе (Trace::startFromEnvironment / Trace::finish).
+class Trace {
+public:
+    static void setEnabled(bool enabled);
+    static bool isEnabled();
+
+    // Время от старта процесса в микросекундах (шкала событий трассы)
+    static qint64 nowUs();
+    // Завершённый интервал: name и category должны жить до выгрузки (строковые литералы)
+    static void record(const char* name, const char* category, qint64 startUs, qint64 durationUs);
+
+    static int eventCount();
+    static void clear();
+    static bool writeChromeTrace(const QString& filename);
+
+    // Включить трассировку, если задан SCRUM_BOARD_TRACE и макросы скомпилированы
+    static void startFromEnvironment();
+    // Записать трассу в файл из SCRUM_BOARD_TRACE (если трассировка была включена)
+    static void finish();
+};
+
+// Замер времени блока; ничего не делает, если трассировка выключена
+class TraceScope {
+public:
+    explicit TraceScope(const char* name, const char* category = "board")
+        : name(name), category(category), startUs(Trace::isEnabled() ? Trace::nowUs() : -1) {}
+    ~TraceScope() { finish(); }
+
+    // Закончить замер раньше конца блока (например, перед показом модального диалога)
+    void finish() {
+        if (startUs >= 0) {
+            Trace::record(name, category, startUs, Trace::nowUs() - startUs);
+            startUs = -1;
+        }
+    }
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* name;
+    const char* category;
+    qint64 startUs;
+};
+
+#ifdef SCRUM_BOARD_TRACING
+#define TRACE_CONCAT_IMPL(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_IMPL(a, b)
+#define TRACE_SCOPE(name) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name)
+#define TRACE_SCOPE_CATEGORY(name, category) TraceScope TRACE_CONCAT(traceScope, __LINE__)(name, category)
+// Именованный замер, который можно закончить раньше: TRACE_BEGIN(span, "имя") ... TRACE_END(span)
+#define TRACE_BEGIN(span, name) TraceScope span(name)
+#define TRACE_END(span) span.finish()
+#else
+#define TRACE_SCOPE(name) ((void)0)
+#define TRACE_SCOPE_CATEGORY(name, category) ((void)0)
+#define TRACE_BEGIN(span, name) ((void)0)
+#define TRACE_END(span) ((void)0)
+#endif
+
+#endif // TRACE_H
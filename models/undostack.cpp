@@ -0,0 +1,91 @@
+#include "undostack.h"
+
+void UndoStack::beginStep(const QString& text) {
+    if (depth++ == 0) {
+        current = UndoStep();
+        current.text = text;
+    }
+}
+
+void UndoStack::endStep() {
+    if (depth == 0 || --depth > 0) {
+        return;
+    }
+    if (!current.redo.isEmpty()) {
+        commit(std::move(current));
+    }
+    current = UndoStep();
+}
+
+void UndoStack::record(BoardOperation redo, BoardOperation undo, const QString& text) {
+    if (suspended) {
+        return;
+    }
+    if (depth > 0) {
+        current.redo.append(std::move(redo));
+        current.undo.append(std::move(undo));
+        return;
+    }
+    UndoStep step;
+    step.text = text;
+    step.redo.append(std::move(redo));
+    step.undo.append(std::move(undo));
+    commit(std::move(step));
+}
+
+void UndoStack::commit(UndoStep step) {
+    for (const UndoStep& dropped : redoSteps) {
+        operations -= size(dropped);
+    }
+    redoSteps.clear(); // После нового изменения повторять нечего
+    operations += size(step);
+    undoSteps.push_back(std::move(step));
+    trim();
+}
+
+void UndoStack::trim() {
+    while (undoSteps.size() > 1
+           && (int(undoSteps.size()) > stepLimit || operations > operationLimit)) {
+        operations -= size(undoSteps.front());
+        undoSteps.pop_front();
+    }
+}
+
+UndoStep UndoStack::takeUndo() {
+    UndoStep step = std::move(undoSteps.back());
+    undoSteps.pop_back();
+    operations -= size(step);
+    return step;
+}
+
+UndoStep UndoStack::takeRedo() {
+    UndoStep step = std::move(redoSteps.back());
+    redoSteps.pop_back();
+    operations -= size(step);
+    return step;
+}
+
+void UndoStack::pushUndo(UndoStep step) {
+    operations += size(step);
+    undoSteps.push_back(std::move(step));
+    trim();
+}
+
+void UndoStack::pushRedo(UndoStep step) {
+    operations += size(step);
+    redoSteps.push_back(std::move(step));
+}
+
+void UndoStack::setLimits(int maxSteps, int maxOperations) {
+    stepLimit = qMax(1, maxSteps);
+    operationLimit = qMax(1, maxOperations);
+    trim();
+}
+
+void UndoStack::clear() {
+    undoSteps.clear();
+    redoSteps.clear();
+    current = UndoStep();
+    depth = 0;
+    operations = 0;
+}
@@ -0,0 +1,71 @@
+#ifndef UNDOSTACK_H
+#define UNDOSTACK_H
+
+#include <QString>
+#include <QVector>
+#include <deque>
+#include "boardoperation.h"
+
+// Шаг отмены: операции в порядке выполнения. redo повторяет шаг, а undo
+// (применяется в обратном порядке) возвращает доску в состояние до шага
+struct UndoStep {
+    QString text;
+    QVector<BoardOperation> redo;
+    QVector<BoardOperation> undo;
+};
+
+// Стек отмены доски. Хранит не копии доски, а пары «операция - обратная операция»,
+// поэтому шаг занимает память по размеру изменения, а отмена стоит O(операций шага).
+// Объём ограничен числом шагов и общим числом операций: старые шаги вытесняются.
+// Заполняет его Board; пользоваться им напрямую нужно только для чтения
+class UndoStack {
+public:
+    static constexpr int defaultStepLimit = 1000;
+    static constexpr int defaultOperationLimit = 100000;
+
+    // Шаг из нескольких изменений. Вложенные шаги сливаются во внешний (текст - внешнего)
+    void beginStep(const QString& text);
+    void endStep();
+
+    // Записать изменение. Вне beginStep()/endStep() оно становится отдельным шагом с текстом text.
+    // Новое изменение очищает стек повтора
+    void record(BoardOperation redo, BoardOperation undo, const QString& text = QString());
+
+    // Пока запись приостановлена (доска применяет отмену или загружает файл), record() ничего не делает
+    void setSuspended(bool value) { suspended = value; }
+    bool isRecording() const { return !suspended; }
+
+    bool canUndo() const { return !undoSteps.empty(); }
+    bool canRedo() const { return !redoSteps.empty(); }
+    QString undoText() const { return canUndo() ? undoSteps.back().text : QString(); }
+    QString redoText() const { return canRedo() ? redoSteps.back().text : QString(); }
+    int undoCount() const { return int(undoSteps.size()); }
+    int redoCount() const { return int(redoSteps.size()); }
+    int operationCount() const { return operations; } // Операций во всех шагах обоих стеков
+
+    UndoStep takeUndo();
+    UndoStep takeRedo();
+    void pushUndo(UndoStep step); // Шаг после повтора: стек повтора не очищается
+    void pushRedo(UndoStep step);
+
+    void setLimits(int maxSteps, int maxOperations);
+    int getStepLimit() const { return stepLimit; }
+    int getOperationLimit() const { return operationLimit; }
+    void clear();
+
+private:
+    std::deque<UndoStep> undoSteps;
+    std::deque<UndoStep> redoSteps;
+    UndoStep current; // Открытый шаг beginStep()
+    int depth = 0;
+    bool suspended = false;
+    int operations = 0;
+    int stepLimit = defaultStepLimit;
+    int operationLimit = defaultOperationLimit;
+
+    void commit(UndoStep step);
+    void trim(); // Вытеснить самые старые шаги сверх ограничений (последний шаг остаётся)
+    static int size(const UndoStep& step) { return step.redo.size(); }
+};
+
+#endif // UNDOSTACK_H
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QTemporaryDir>
+#include "../models/board.h"
+#include "../models/binaryboardfile.h"
+
+// Тесты двоичного формата доски
+class BinaryFormatTest : public ::testing::Test {
+protected:
+    QTemporaryDir dir;
+    Board board;
+    int devId = -1;
+
+    void SetUp() override {
+        Developer dev("Мария", "Тестировщик");
+        devId = dev.getId();
+        board.addDeveloper(dev);
+
+        for (int i = 0; i < 50; i++) {
+            Task task(QString("Задача %1").arg(i), QString("Описание \"%1\"").arg(i));
+            if (i % 2 == 0) {
+                task.assignToDeveloper(devId);
+            }
+            if (i % 3 == 0) {
+                task.setDeadline(QDateTime::currentDateTime().addDays(i));
+            }
+            task.setStatus(TaskStatus(i % 5));
+            board.addTask(task);
+        }
+    }
+
+    QString path(const QString& name) const { return dir.filePath(name); }
+};
+
+TEST_F(BinaryFormatTest, RoundTrip) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path("board.sbb")));
+    ASSERT_EQ(loaded.getTasks().size(), board.getTasks().size());
+    EXPECT_EQ(loaded.getDevelopers().size(), 1);
+    EXPECT_EQ(loaded.getDeveloper(devId)->getPosition(), "Тестировщик");
+
+    for (const Task& task : board.getTasks()) {
+        const Task* copy = loaded.getTask(task.getId());
+        ASSERT_NE(copy, nullptr);
+        EXPECT_EQ(copy->getTitle(), task.getTitle());
+        EXPECT_EQ(copy->getDescription(), task.getDescription());
+        EXPECT_EQ(copy->getStatus(), task.getStatus());
+        EXPECT_EQ(copy->getAssignedDeveloperId(), task.getAssignedDeveloperId());
+        EXPECT_EQ(copy->getDeadline().toMSecsSinceEpoch(), task.getDeadline().toMSecsSinceEpoch());
+        EXPECT_EQ(copy->getDeadline().isValid(), task.getDeadline().isValid());
+        EXPECT_EQ(copy->getHistory().size(), task.getHistory().size());
+    }
+}
+
+TEST_F(BinaryFormatTest, LazyAccess) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+
+    BinaryBoardFile file(path("board.sbb"));
+    ASSERT_TRUE(file.open());
+    EXPECT_EQ(file.taskCount(), 50);
+
+    // Отдельная задача и её история читаются без разбора остальных
+    Task task = file.task(10, BinaryBoardFile::HistoryMode::Skip);
+    EXPECT_EQ(task.getTitle(), "Задача 10");
+    EXPECT_TRUE(task.getHistory().isEmpty());
+    EXPECT_EQ(file.history(10).size(), board.getTask(task.getId())->getHistory().size());
+}
+
+TEST_F(BinaryFormatTest, ConvertJsonAndBack) {
+    ASSERT_TRUE(board.saveToFile(path("board.json")));
+    ASSERT_TRUE(Board::convertFile(path("board.json"), path("board.sbb")));
+    ASSERT_TRUE(Board::convertFile(path("board.sbb"), path("back.json")));
+
+    Board fromJson;
+    ASSERT_TRUE(fromJson.loadFromFile(path("back.json")));
+    EXPECT_EQ(fromJson.getTasks().size(), 50);
+    EXPECT_EQ(fromJson.countTasksByDeveloper(devId), 25);
+}
+
+TEST_F(BinaryFormatTest, RejectsCorruptedFile) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+
+    QFile file(path("board.sbb"));
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    file.resize(file.size() / 2); // Обрезанный файл
+    file.close();
+
+    Board loaded;
+    EXPECT_FALSE(loaded.loadFromFile(path("board.sbb")));
+
+    QFile garbage(path("garbage.sbb"));
+    ASSERT_TRUE(garbage.open(QIODevice::WriteOnly));
+    garbage.write(QByteArray(128, 'x'));
+    garbage.close();
+    EXPECT_FALSE(loaded.loadFromFile(path("garbage.sbb")));
+}
+
+// Ссылки внутри записей проверяются при чтении, а не при открытии
+TEST_F(BinaryFormatTest, CorruptedRecordIsReadAsEmpty) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+    {
+        QFile file(path("board.sbb"));
+        ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+        const qint64 record = 64 + 12; // Первая задача: после заголовка и одного разработчика
+        const QByteArray outOfRange(4, char(0x7F));
+        ASSERT_TRUE(file.seek(record + 4)); // Номер строки названия
+        file.write(outOfRange);
+        ASSERT_TRUE(file.seek(record + 36)); // Число записей истории
+        file.write(outOfRange);
+    }
+
+    BinaryBoardFile file(path("board.sbb"));
+    ASSERT_TRUE(file.open());
+    Task broken = file.task(0);
+    EXPECT_TRUE(broken.getTitle().isEmpty());
+    EXPECT_TRUE(broken.getHistory().isEmpty());
+    EXPECT_TRUE(file.history(0).isEmpty());
+    EXPECT_EQ(file.task(1).getTitle(), "Задача 1");
+    EXPECT_FALSE(file.history(1).isEmpty());
+}
+
+TEST_F(BinaryFormatTest, HistoryIsReadOnDemand) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path("board.sbb")));
+    Task* task = &loaded.getTasks().first();
+    const Task* original = board.getTask(task->getId());
+
+    EXPECT_TRUE(task->getHistory().isLazy()); // Записи остались в файле
+    ASSERT_EQ(task->getHistory().size(), original->getHistory().size());
+    EXPECT_EQ(task->getHistory().last().getDetails(), original->getHistory().last().getDetails());
+
+    // Новые записи добавляются после сохранённых, не читая их
+    int before = task->getHistory().size();
+    task->setTitle("Новое название");
+    EXPECT_TRUE(task->getHistory().isLazy());
+    EXPECT_EQ(task->getHistory().size(), before + 1);
+    EXPECT_EQ(task->getHistory().last().getAction(), "Изменение названия");
+    EXPECT_EQ(task->getHistory().toList().size(), before + 1);
+}
+
+TEST_F(BinaryFormatTest, SaveOverSourceFile) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path("board.sbb")));
+    loaded.getTasks().first().addHistoryEntry("Тест", "Перед пересохранением");
+
+    // История читается из того же файла, который перезаписываем. В память её переносят
+    // только там, где отображённый файл нельзя заменить (Windows)
+    ASSERT_TRUE(loaded.saveToFile(path("board.sbb")));
+#ifdef Q_OS_WIN
+    EXPECT_FALSE(loaded.getTasks().first().getHistory().isLazy());
+#else
+    EXPECT_TRUE(loaded.getTasks().first().getHistory().isLazy());
+#endif
+    EXPECT_EQ(loaded.getTasks().first().getHistory().first().getAction(), "Создание");
+
+    Board reloaded;
+    ASSERT_TRUE(reloaded.loadFromFile(path("board.sbb")));
+    EXPECT_EQ(reloaded.getTasks().first().getHistory().last().getDetails(), "Перед пересохранением");
+}
+
+TEST_F(BinaryFormatTest, SnapshotKeepsHistoryLazy) {
+    ASSERT_TRUE(board.saveToFile(path("board.sbb")));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path("board.sbb")));
+    // Снимок для записи в другой файл историю не читает
+    BoardSnapshot snapshot = loaded.snapshot(path("copy.sbb"));
+    EXPECT_TRUE(loaded.getTasks().first().getHistory().isLazy());
+    ASSERT_TRUE(Board::saveSnapshot(snapshot, path("copy.sbb")));
+    EXPECT_TRUE(loaded.getTasks().first().getHistory().isLazy());
+}
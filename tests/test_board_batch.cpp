@@ -0,0 +1,91 @@
+#include <gtest/gtest.h>
+#include "../models/board.h"
+
+// Тесты пакетного изменения доски
+class BoardBatchTest : public ::testing::Test {
+protected:
+    Board board;
+    QList<int> ids;
+
+    void SetUp() override {
+        for (int i = 0; i < 5; i++) {
+            Task task(QString("Задача %1").arg(i));
+            task.setStatus(TaskStatus::Review);
+            ids.append(task.getId());
+            board.addTask(task);
+        }
+        board.takeChanges();
+    }
+};
+
+TEST_F(BoardBatchTest, AppliesAllOperations) {
+    QVector<BoardOperation> operations;
+    for (int id : ids) {
+        operations.append(BoardOperation::setStatus(id, TaskStatus::Done));
+    }
+    Task added("Новая");
+    operations.append(BoardOperation::addTask(added));
+    operations.append(BoardOperation::removeTask(ids[0]));
+
+    ASSERT_TRUE(board.applyBatch(operations));
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Review), 0);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Done), 4);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Backlog), 1);
+    EXPECT_EQ(board.getStats().total, 5);
+    EXPECT_FALSE(board.hasTask(ids[0]));
+    EXPECT_EQ(board.getTask(ids[1])->getHistory().last().getDetails(), "Review → Done");
+
+    BoardChanges changes = board.takeChanges();
+    EXPECT_EQ(changes.changed.size(), 5);
+    EXPECT_TRUE(changes.removed.contains(ids[0]));
+
+    // Удаление не переставляет остальные задачи; новая - в конце
+    QList<int> order;
+    for (const Task& task : board.getTasks()) {
+        order.append(task.getId());
+    }
+    EXPECT_EQ(order, QList<int>({ids[1], ids[2], ids[3], ids[4], added.getId()}));
+}
+
+TEST_F(BoardBatchTest, FailedBatchLeavesBoardUntouched) {
+    const quint64 revision = board.getRevision();
+    QVector<BoardOperation> operations;
+    operations.append(BoardOperation::setStatus(ids[0], TaskStatus::Done));
+    operations.append(BoardOperation::removeTask(ids[1]));
+    operations.append(BoardOperation::setStatus(ids[1], TaskStatus::Done)); // Уже удалена пакетом
+
+    QString error;
+    EXPECT_FALSE(board.applyBatch(operations, &error));
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_EQ(board.getTask(ids[0])->getStatus(), TaskStatus::Review);
+    EXPECT_TRUE(board.hasTask(ids[1]));
+    EXPECT_EQ(board.getRevision(), revision);
+    EXPECT_TRUE(board.takeChanges().isEmpty());
+}
+
+TEST_F(BoardBatchTest, AssignRequiresExistingDeveloper) {
+    Developer dev("Иван", "Разработчик");
+    board.addDeveloper(dev);
+
+    QVector<BoardOperation> operations;
+    operations.append(BoardOperation::assign(ids[0], dev.getId()));
+    operations.append(BoardOperation::assign(ids[1], dev.getId() + 1000));
+    EXPECT_FALSE(board.applyBatch(operations));
+    EXPECT_EQ(board.countTasksByDeveloper(dev.getId()), 0);
+
+    operations.removeLast();
+    ASSERT_TRUE(board.applyBatch(operations));
+    EXPECT_EQ(board.countTasksByDeveloper(dev.getId()), 1);
+    EXPECT_EQ(board.getStats().unassignedActive, 4);
+}
+
+TEST_F(BoardBatchTest, SearchIndexUpdatedAtCommit) {
+    Task task("Уникальное название");
+    QVector<BoardOperation> operations;
+    operations.append(BoardOperation::addTask(task));
+    operations.append(BoardOperation::setStatus(task.getId(), TaskStatus::InProgress));
+    ASSERT_TRUE(board.applyBatch(operations));
+
+    EXPECT_TRUE(board.searchTasks("уникальное").contains(task.getId()));
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::InProgress), 1);
+}
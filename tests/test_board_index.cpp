@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+#include "../models/board.h"
+
+// Тесты индексов доски: поиск и удаление по ID
+class BoardIndexTest : public ::testing::Test {
+protected:
+    Board board;
+};
+
+TEST_F(BoardIndexTest, GetTaskAfterAdd) {
+    Task task1("Задача 1");
+    Task task2("Задача 2");
+    board.addTask(task1);
+    board.addTask(task2);
+
+    ASSERT_NE(board.getTask(task2.getId()), nullptr);
+    EXPECT_EQ(board.getTask(task2.getId())->getTitle(), "Задача 2");
+    EXPECT_TRUE(board.hasTask(task1.getId()));
+}
+
+TEST_F(BoardIndexTest, GetMissingTaskReturnsNull) {
+    EXPECT_EQ(board.getTask(-42), nullptr);
+    EXPECT_FALSE(board.hasTask(-42));
+}
+
+TEST_F(BoardIndexTest, IdsSurviveRemovalFromMiddle) {
+    QList<int> ids;
+    for (int i = 0; i < 10; i++) {
+        Task task(QString("Задача %1").arg(i));
+        ids.append(task.getId());
+        board.addTask(task);
+    }
+
+    EXPECT_TRUE(board.removeTask(ids[3]));
+    EXPECT_TRUE(board.removeTask(ids[0]));
+    EXPECT_FALSE(board.removeTask(ids[0])); // Повторное удаление
+
+    EXPECT_EQ(board.getTasks().size(), 8);
+    EXPECT_EQ(board.getTask(ids[3]), nullptr);
+    for (int i : {1, 2, 4, 5, 6, 7, 8, 9}) {
+        Task* task = board.getTask(ids[i]);
+        ASSERT_NE(task, nullptr);
+        EXPECT_EQ(task->getTitle(), QString("Задача %1").arg(i));
+    }
+
+    // Остальные задачи идут в прежнем порядке
+    QList<int> order;
+    for (const Task& task : board.getTasks()) {
+        order.append(task.getId());
+    }
+    EXPECT_EQ(order, QList<int>({ids[1], ids[2], ids[4], ids[5], ids[6], ids[7], ids[8], ids[9]}));
+}
+
+TEST_F(BoardIndexTest, RemoveLastTask) {
+    Task task1("Первая");
+    Task task2("Последняя");
+    board.addTask(task1);
+    board.addTask(task2);
+
+    EXPECT_TRUE(board.removeTask(task2.getId()));
+    ASSERT_NE(board.getTask(task1.getId()), nullptr);
+    EXPECT_EQ(board.getTask(task1.getId())->getTitle(), "Первая");
+}
+
+TEST_F(BoardIndexTest, AddTaskWithExistingIdReplaces) {
+    Task task("Старое название");
+    board.addTask(task);
+    task.setTitle("Новое название");
+    board.addTask(task);
+
+    EXPECT_EQ(board.getTasks().size(), 1);
+    EXPECT_EQ(board.getTask(task.getId())->getTitle(), "Новое название");
+}
+
+TEST_F(BoardIndexTest, RemoveDeveloperKeepsOthersReachable) {
+    Developer dev1("Иван");
+    Developer dev2("Пётр");
+    Developer dev3("Анна");
+    board.addDeveloper(dev1);
+    board.addDeveloper(dev2);
+    board.addDeveloper(dev3);
+
+    Task task("Задача");
+    task.assignToDeveloper(dev1.getId());
+    board.addTask(task);
+
+    EXPECT_TRUE(board.removeDeveloper(dev1.getId()));
+    EXPECT_EQ(board.getDeveloper(dev1.getId()), nullptr);
+    ASSERT_NE(board.getDeveloper(dev3.getId()), nullptr);
+    EXPECT_EQ(board.getDeveloper(dev3.getId())->getName(), "Анна");
+    EXPECT_FALSE(board.getTask(task.getId())->isAssigned());
+}
+
+TEST_F(BoardIndexTest, IndexesResetOnClear) {
+    Task task("Задача");
+    board.addTask(task);
+    board.clear();
+
+    EXPECT_EQ(board.getTask(task.getId()), nullptr);
+    EXPECT_FALSE(board.removeTask(task.getId()));
+}
+
+// Вторичные индексы: статус → задачи, разработчик → задачи
+
+TEST_F(BoardIndexTest, StatusIndexFollowsSetStatus) {
+    Task task1("Задача 1");
+    Task task2("Задача 2");
+    board.addTask(task1);
+    board.addTask(task2);
+
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Backlog), 2);
+
+    board.getTask(task1.getId())->setStatus(TaskStatus::Review);
+
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Backlog), 1);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Review), 1);
+    QList<Task*> review = board.getTasksByStatus(TaskStatus::Review);
+    ASSERT_EQ(review.size(), 1);
+    EXPECT_EQ(review.first()->getId(), task1.getId());
+}
+
+TEST_F(BoardIndexTest, DeveloperIndexFollowsAssignment) {
+    Developer dev("Иван");
+    board.addDeveloper(dev);
+    Task task("Задача");
+    board.addTask(task);
+
+    EXPECT_EQ(board.countTasksByDeveloper(-1), 1);
+
+    board.getTask(task.getId())->assignToDeveloper(dev.getId());
+    EXPECT_EQ(board.countTasksByDeveloper(dev.getId()), 1);
+    EXPECT_EQ(board.countTasksByDeveloper(-1), 0);
+
+    board.getTask(task.getId())->unassign();
+    EXPECT_EQ(board.countTasksByDeveloper(dev.getId()), 0);
+    EXPECT_TRUE(board.getTasksByDeveloper(-1).size() == 1);
+}
+
+TEST_F(BoardIndexTest, CopyOfBoardTaskDoesNotChangeIndex) {
+    Task task("Задача");
+    board.addTask(task);
+
+    Task copy = *board.getTask(task.getId()); // Наблюдатель не копируется
+    copy.setStatus(TaskStatus::Done);
+    copy = *board.getTask(task.getId()); // И не переносится присваиванием
+    copy.setTitle("Копия");
+
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Done), 0);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Backlog), 1);
+    EXPECT_EQ(board.getTask(task.getId())->getTitle(), "Задача");
+}
+
+TEST_F(BoardIndexTest, IndexesFollowRemovalAndReplacement) {
+    Task task1("Задача 1");
+    Task task2("Задача 2");
+    task2.setStatus(TaskStatus::Done);
+    board.addTask(task1);
+    board.addTask(task2);
+
+    board.removeTask(task1.getId());
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Backlog), 0);
+
+    // Повторная задача с тем же ID и новым статусом заменяет запись в индексе
+    task2.setStatus(TaskStatus::Review);
+    board.addTask(task2);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Done), 0);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Review), 1);
+
+    // После переноса последней задачи в освободившийся слот индекс всё ещё верен
+    board.getTask(task2.getId())->setStatus(TaskStatus::InProgress);
+    EXPECT_EQ(board.getTasksByStatus(TaskStatus::InProgress).size(), 1);
+}
+
+TEST_F(BoardIndexTest, HasUnassignedTasksIgnoresBacklog) {
+    Task task("Задача");
+    board.addTask(task);
+    EXPECT_FALSE(board.hasUnassignedTasks());
+
+    board.getTask(task.getId())->setStatus(TaskStatus::InProgress);
+    EXPECT_TRUE(board.hasUnassignedTasks());
+}
+
+// Журнал изменений для инкрементального обновления интерфейса
+
+TEST_F(BoardIndexTest, TakeChangesReportsChangedAndRemoved) {
+    Task task1("Задача 1");
+    Task task2("Задача 2");
+    board.addTask(task1);
+    board.addTask(task2);
+    board.takeChanges(); // Первый вызов - полная перестройка
+
+    board.getTask(task1.getId())->setStatus(TaskStatus::Review);
+    board.removeTask(task2.getId());
+
+    BoardChanges changes = board.takeChanges();
+    EXPECT_FALSE(changes.reset);
+    EXPECT_TRUE(changes.changed.contains(task1.getId()));
+    EXPECT_TRUE(changes.removed.contains(task2.getId()));
+    EXPECT_FALSE(changes.changed.contains(task2.getId()));
+
+    EXPECT_TRUE(board.takeChanges().isEmpty()); // Журнал очищен
+}
+
+TEST_F(BoardIndexTest, RemovalDoesNotMoveOtherTasks) {
+    Task task1("Задача 1");
+    Task task2("Задача 2");
+    board.addTask(task1);
+    board.addTask(task2);
+    Task* pointer = board.getTask(task2.getId());
+    board.takeChanges();
+
+    board.removeTask(task1.getId()); // task2 сдвигается на место task1 только в списке
+
+    BoardChanges changes = board.takeChanges();
+    EXPECT_FALSE(changes.reset);
+    EXPECT_FALSE(changes.changed.contains(task2.getId()));
+    EXPECT_EQ(board.getTask(task2.getId()), pointer);
+}
+
+TEST_F(BoardIndexTest, ClearResetsChanges) {
+    Task task("Задача");
+    board.addTask(task);
+    board.takeChanges();
+
+    board.clear();
+    EXPECT_TRUE(board.takeChanges().reset);
+}
@@ -0,0 +1,144 @@
+#include <gtest/gtest.h>
+#include "../models/board.h"
+
+// Тесты языка запросов и планировщика BoardQuery
+class BoardQueryTest : public ::testing::Test {
+protected:
+    Board board;
+    int devId = -1;
+
+    // 200 задач: каждая вторая в Review, каждая двадцатая назначена разработчику
+    void SetUp() override {
+        devId = board.createDeveloper("Иван")->getId();
+        for (int i = 0; i < 200; i++) {
+            Task* task = board.createTask(i % 7 == 0 ? QString("Логин %1").arg(i) : QString("Задача %1").arg(i));
+            if (i % 2 == 0) {
+                task->setStatus(TaskStatus::Review);
+            }
+            if (i % 20 == 0) {
+                task->assignToDeveloper(devId);
+            }
+        }
+    }
+
+    QueryResult run(const QString& text) {
+        BoardQuery query;
+        QString error;
+        EXPECT_TRUE(BoardQuery::parse(text, query, &error)) << error.toStdString();
+        return board.query(query);
+    }
+
+    // Тот же отбор перебором через matches()
+    QSet<int> matchEach(const QString& text) {
+        BoardQuery query;
+        BoardQuery::parse(text, query);
+        QSet<int> ids;
+        for (const Task& task : board.getTasks()) {
+            if (query.matches(board, task)) {
+                ids.insert(task.getId());
+            }
+        }
+        return ids;
+    }
+};
+
+TEST_F(BoardQueryTest, ParsesPrecedenceAndNegation) {
+    BoardQuery query;
+    ASSERT_TRUE(BoardQuery::parse("status:review -assignee:none OR history:Status", query));
+    EXPECT_FALSE(query.isPlainText());
+    EXPECT_EQ(query.toString(), QString("(status:Review AND -assignee:none) OR history:status"));
+
+    ASSERT_TRUE(BoardQuery::parse("status:Done (text:\"два слова\" OR due:..2026-03-31)", query));
+    EXPECT_EQ(query.toString(), QString("status:Done AND (text:\"два слова\" OR due:..2026-03-31)"));
+}
+
+TEST_F(BoardQueryTest, PlainWordsAreText) {
+    BoardQuery query;
+    ASSERT_TRUE(BoardQuery::parse("исправить or вход", query));
+    EXPECT_TRUE(query.isPlainText());
+    EXPECT_EQ(query.plainText(), QString("исправить or вход"));
+    ASSERT_TRUE(BoardQuery::parse("\"исправить вход\"", query));
+    EXPECT_TRUE(query.isPlainText());
+    EXPECT_EQ(query.plainText(), QString("исправить вход")); // Без кавычек
+    ASSERT_TRUE(BoardQuery::parse("is:overdue", query));
+    EXPECT_FALSE(query.isPlainText());
+}
+
+TEST_F(BoardQueryTest, NestingDepthIsLimited) {
+    BoardQuery query;
+    QString error;
+    EXPECT_FALSE(BoardQuery::parse(QString(10000, '(') + "status:Done" + QString(10000, ')'), query, &error));
+    EXPECT_FALSE(error.isEmpty());
+    EXPECT_FALSE(BoardQuery::parse(QString("NOT ").repeated(10000) + "status:Done", query, &error));
+
+    // Умеренная вложенность разбирается
+    ASSERT_TRUE(BoardQuery::parse(QString(20, '(') + "status:Done" + QString(20, ')'), query, &error));
+    EXPECT_EQ(query.toString(), QString("status:Done"));
+}
+
+TEST_F(BoardQueryTest, ReportsParseErrors) {
+    for (const char* text : {"status:Later", "(status:Review", "status:Review)", "due:2026-13-01",
+                             "owner:3", "text:\"без конца", "assignee:Иван", "OR status:Done"}) {
+        BoardQuery query;
+        QString error;
+        EXPECT_FALSE(BoardQuery::parse(QString::fromUtf8(text), query, &error)) << text;
+        EXPECT_FALSE(error.isEmpty()) << text;
+    }
+}
+
+TEST_F(BoardQueryTest, AndStartsFromSmallestIndex) {
+    QueryResult result = run(QString("status:Review assignee:%1").arg(devId));
+    EXPECT_TRUE(result.usedIndex);
+    EXPECT_EQ(result.ids.size(), 10);
+    // Индекс разработчика меньше: из него 10 кандидатов, статус проверен только у них
+    EXPECT_EQ(result.fromIndex, 10);
+    EXPECT_EQ(result.examined, 10);
+    EXPECT_TRUE(result.plan.contains("индекс разработчиков"));
+}
+
+TEST_F(BoardQueryTest, UnindexedQueryScansBoard) {
+    QueryResult result = run("-status:Review");
+    EXPECT_FALSE(result.usedIndex);
+    EXPECT_EQ(result.ids.size(), 100);
+    EXPECT_EQ(result.examined, 200);
+    EXPECT_TRUE(result.plan.contains("просмотр всех задач"));
+
+    result = run("history:assigned");
+    EXPECT_EQ(result.ids.size(), 10);
+    EXPECT_EQ(result.ids, matchEach("history:assigned"));
+}
+
+TEST_F(BoardQueryTest, OrOfIndexedConditionsIsUnion) {
+    QueryResult result = run(QString("text:логин OR assignee:%1").arg(devId));
+    EXPECT_TRUE(result.usedIndex);
+    EXPECT_EQ(result.examined, 0);
+    EXPECT_EQ(result.ids, matchEach(QString("text:логин OR assignee:%1").arg(devId)));
+}
+
+TEST_F(BoardQueryTest, DeadlineConditionsUseBoardClock) {
+    const QDateTime now = QDateTime::currentDateTime();
+    Task* overdue = board.createTask("Просрочена");
+    overdue->setDeadline(now.addDays(-1));
+    Task* done = board.createTask("Сделана");
+    done->setDeadline(now.addDays(-1));
+    done->setStatus(TaskStatus::Done);
+    Task* soon = board.createTask("Скоро");
+    soon->setDeadline(QDateTime(QDate::currentDate().addDays(2), QTime(12, 0)));
+
+    EXPECT_EQ(run("is:overdue").ids, QSet<int>({overdue->getId()}));
+
+    const QString range = QString("due:%1..%2").arg(QDate::currentDate().toString(Qt::ISODate),
+                                                   QDate::currentDate().addDays(3).toString(Qt::ISODate));
+    EXPECT_EQ(run(range).ids, QSet<int>({soon->getId()}));
+    EXPECT_EQ(run("due:" + QDate::currentDate().addDays(2).toString(Qt::ISODate)).ids, QSet<int>({soon->getId()}));
+}
+
+TEST_F(BoardQueryTest, MatchesAgreesWithRun) {
+    for (const QString& text : {QString("status:Review OR -text:логин"),
+                                QString("(status:Backlog OR status:Review) history:status"),
+                                QString("assignee:none -status:Review"),
+                                QString("логин assignee:%1").arg(devId),
+                                QString()}) {
+        EXPECT_EQ(run(text).ids, matchEach(text)) << text.toStdString();
+    }
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include <thread>
+#include <vector>
+#include "../models/board.h"
+
+// Тесты снимков доски для фонового сохранения
+TEST(BoardSnapshotTest, SnapshotIsIsolatedFromBoard) {
+    Board board;
+    Task task("До снимка");
+    int taskId = task.getId();
+    board.addTask(task);
+    Task* stored = board.getTask(taskId);
+
+    BoardSnapshot snapshot = board.snapshot();
+    quint64 revision = board.getRevision();
+
+    stored->setTitle("После снимка");
+    EXPECT_EQ(board.getTask(taskId), stored); // Снимок не заставил доску переложить задачи
+    EXPECT_EQ(snapshot.tasks.first().getTitle(), "До снимка");
+    EXPECT_GT(board.getRevision(), revision);
+    EXPECT_EQ(snapshot.revision, revision);
+}
+
+TEST(BoardSnapshotTest, SaveOnWorkerThread) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("board.json");
+
+    Board board;
+    for (int i = 0; i < 500; i++) {
+        board.addTask(Task(QString("Задача %1").arg(i)));
+    }
+    BoardSnapshot snapshot = board.snapshot(path);
+
+    bool saved = false;
+    int lastWritten = 0;
+    std::thread worker([&]() {
+        saved = Board::saveSnapshot(snapshot, path, [&](int written, int /*total*/) {
+            lastWritten = written;
+        });
+    });
+    // Доска продолжает меняться, пока снимок пишется
+    for (int i = 0; i < 100; i++) {
+        board.getTasks()[i].setStatus(TaskStatus::Done);
+    }
+    worker.join();
+
+    ASSERT_TRUE(saved);
+    EXPECT_EQ(lastWritten, 500);
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    EXPECT_EQ(loaded.getTasks().size(), 500);
+    EXPECT_EQ(loaded.countTasksByStatus(TaskStatus::Done), 0);
+}
+
+TEST(BoardSnapshotTest, QueriesOnWorkerThread) {
+    Board board;
+    Developer dev("Иван");
+    board.addDeveloper(dev);
+    QList<int> ids;
+    for (int i = 0; i < 300; i++) {
+        Task* task = board.createTask(QString("Задача %1").arg(i));
+        task->setStatus(i % 3 == 0 ? TaskStatus::Review : TaskStatus::InProgress);
+        if (i % 2 == 0) task->assignToDeveloper(dev.getId());
+        ids.append(task->getId());
+    }
+    BoardSnapshot snapshot = board.snapshot();
+
+    int review = 0;
+    int assigned = 0;
+    bool titlesMatch = true;
+    std::thread worker([&]() {
+        review = snapshot.tasksByStatus(TaskStatus::Review).size();
+        assigned = snapshot.tasksByDeveloper(dev.getId()).size();
+        for (int i = 0; i < ids.size(); i++) {
+            const Task* task = snapshot.task(ids[i]);
+            titlesMatch = titlesMatch && task && task->getTitle() == QString("Задача %1").arg(i);
+        }
+    });
+    // Доска меняется, пока поток читает снимок
+    for (int taskId : ids.mid(0, 100)) {
+        board.removeTask(taskId);
+    }
+    worker.join();
+
+    EXPECT_EQ(review, 100);
+    EXPECT_EQ(assigned, 150);
+    EXPECT_TRUE(titlesMatch);
+}
+
+// Счётчики ID: атомарные и отдельные для каждой доски
+TEST(BoardIdsTest, CreateTaskContinuesBoardIds) {
+    Board board;
+    Task* first = board.createTask("Первая");
+    Task* second = board.createTask("Вторая");
+    EXPECT_EQ(first->getId(), 1);
+    EXPECT_EQ(second->getId(), 2);
+    EXPECT_EQ(second->getHistory().first().getDetails(), "Задача 'Вторая' создана");
+
+    // Другая доска со своими большими ID не влияет на эту
+    Board other;
+    Task big("Чужая");
+    other.addTask(big);
+    other.createTask("Ещё");
+    EXPECT_EQ(board.createTask("Третья")->getId(), 3);
+
+    // Задача, добавленная извне, сдвигает счётчик доски
+    Task external(100, "Внешняя");
+    board.addTask(external);
+    EXPECT_EQ(board.createTask("Четвёртая")->getId(), 101);
+
+    board.clear();
+    EXPECT_EQ(board.createDeveloper("Анна")->getId(), 1);
+}
+
+TEST(BoardIdsTest, LoadingDoesNotTouchGlobalIds) {
+    QTemporaryDir dir;
+    Board board;
+    board.addTask(Task(100000000, "Большой ID"));
+    board.addDeveloper(Developer(100000000, "Большой ID"));
+
+    for (const QString& name : {QString("board.json"), QString("board.sbb")}) {
+        ASSERT_TRUE(board.saveToFile(dir.filePath(name)));
+        Board loaded;
+        ASSERT_TRUE(loaded.loadFromFile(dir.filePath(name)));
+        EXPECT_EQ(loaded.createTask("Следующая")->getId(), 100000001);
+
+        // Загрузка сдвинула только счётчики загруженной доски
+        EXPECT_LT(Task("Отдельная").getId(), 100000000);
+        EXPECT_LT(Developer("Отдельный").getId(), 100000000);
+    }
+}
+
+TEST(BoardIdsTest, ConcurrentAllocationIsUnique) {
+    IdAllocator ids;
+    const int perThread = 10000;
+    QVector<int> results[4];
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; t++) {
+        workers.emplace_back([&ids, &results, t]() {
+            for (int i = 0; i < perThread; i++) {
+                results[t].append(ids.allocate());
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+
+    QSet<int> unique;
+    for (const QVector<int>& list : results) {
+        for (int id : list) {
+            unique.insert(id);
+        }
+    }
+    EXPECT_EQ(unique.size(), 4 * perThread);
+    EXPECT_EQ(ids.peek(), 4 * perThread + 1);
+
+    ids.reserve(100); // Назад счётчик не сдвигается
+    EXPECT_EQ(ids.peek(), 4 * perThread + 1);
+}
@@ -0,0 +1,117 @@
+#include <gtest/gtest.h>
+#include "../models/board.h"
+#include <QThread>
+
+// Тесты инкрементальной статистики доски
+class BoardStatsTest : public ::testing::Test {
+protected:
+    Board board;
+
+    int addTask(const QString& title, const QDateTime& deadline = QDateTime()) {
+        Task task(title);
+        task.setDeadline(deadline);
+        board.addTask(task);
+        return task.getId();
+    }
+};
+
+TEST_F(BoardStatsTest, EmptyBoard) {
+    const BoardStats& stats = board.getStats();
+    EXPECT_EQ(stats.total, 0);
+    EXPECT_EQ(stats.percentDone(), 0);
+    EXPECT_FALSE(board.hasUnassignedTasks());
+}
+
+TEST_F(BoardStatsTest, StatusCountersFollowChanges) {
+    int id1 = addTask("Задача 1");
+    addTask("Задача 2");
+
+    board.getTask(id1)->setStatus(TaskStatus::Done);
+
+    const BoardStats& stats = board.getStats();
+    EXPECT_EQ(stats.total, 2);
+    EXPECT_EQ(stats.count(TaskStatus::Backlog), 1);
+    EXPECT_EQ(stats.count(TaskStatus::Done), 1);
+    EXPECT_EQ(stats.percentDone(), 50);
+
+    board.removeTask(id1);
+    EXPECT_EQ(board.getStats().total, 1);
+    EXPECT_EQ(board.getStats().count(TaskStatus::Done), 0);
+}
+
+TEST_F(BoardStatsTest, DeadlineBuckets) {
+    QDateTime now = QDateTime::currentDateTime();
+    addTask("Просрочена", now.addDays(-2));
+    addTask("Через 2 дня", QDateTime(QDate::currentDate().addDays(2), QTime(23, 59, 59)));
+    addTask("Через месяц", now.addDays(30));
+    addTask("Без дедлайна");
+
+    const BoardStats& stats = board.getStats();
+    EXPECT_EQ(stats.overdue, 1);
+    EXPECT_EQ(stats.dueSoon, 1);
+}
+
+TEST_F(BoardStatsTest, DoneTaskLeavesDeadlineBuckets) {
+    int id = addTask("Просрочена", QDateTime::currentDateTime().addDays(-1));
+    EXPECT_EQ(board.getStats().overdue, 1);
+
+    board.getTask(id)->setStatus(TaskStatus::Done);
+    EXPECT_EQ(board.getStats().overdue, 0);
+}
+
+TEST_F(BoardStatsTest, DeadlineChangeMovesBucket) {
+    int id = addTask("Задача", QDateTime::currentDateTime().addDays(-1));
+    board.getTask(id)->setDeadline(QDateTime::currentDateTime().addDays(30));
+
+    EXPECT_EQ(board.getStats().overdue, 0);
+    EXPECT_EQ(board.getStats().dueSoon, 0);
+}
+
+TEST_F(BoardStatsTest, PassedDeadlineIsReportedOnce) {
+    QDateTime deadline = QDateTime::currentDateTime().addMSecs(100);
+    int id = addTask("Скоро дедлайн", deadline);
+    addTask("Через месяц", deadline.addDays(30));
+    board.takeChanges();
+    quint64 revision = board.getRevision();
+
+    EXPECT_EQ(board.nextDeadlineTransition(), deadline.addMSecs(1));
+    EXPECT_EQ(board.getDeadlineBucket(*board.getTask(id)), DeadlineBucket::Today);
+
+    QThread::msleep(150);
+    EXPECT_EQ(board.updateDeadlines(), 1); // Задача через месяц корзину не сменила
+    EXPECT_EQ(board.getStats().overdue, 1);
+    EXPECT_EQ(board.getStats().dueToday, 0);
+    EXPECT_EQ(board.getDeadlineBucket(*board.getTask(id)), DeadlineBucket::Overdue);
+
+    BoardChanges changes = board.takeChanges();
+    EXPECT_EQ(changes.changed, QSet<int>({id}));
+    EXPECT_EQ(board.getRevision(), revision); // Содержимое доски не менялось
+    EXPECT_EQ(board.updateDeadlines(), 0);
+}
+
+TEST_F(BoardStatsTest, NoTransitionForPassedOrDoneDeadlines) {
+    addTask("Просрочена", QDateTime::currentDateTime().addDays(-1));
+    int id = addTask("Сделана", QDateTime::currentDateTime().addDays(5));
+    board.getTask(id)->setStatus(TaskStatus::Done);
+    EXPECT_FALSE(board.nextDeadlineTransition().isValid());
+
+    board.getTask(id)->setStatus(TaskStatus::Review); // Снова в работе - дедлайн снова важен
+    EXPECT_TRUE(board.nextDeadlineTransition().isValid());
+    board.removeTask(id);
+    EXPECT_FALSE(board.nextDeadlineTransition().isValid());
+}
+
+TEST_F(BoardStatsTest, UnassignedActiveCounter) {
+    Developer dev("Иван");
+    board.addDeveloper(dev);
+    int id = addTask("Задача");
+
+    board.getTask(id)->setStatus(TaskStatus::InProgress);
+    EXPECT_TRUE(board.hasUnassignedTasks());
+
+    board.getTask(id)->assignToDeveloper(dev.getId());
+    EXPECT_FALSE(board.hasUnassignedTasks());
+
+    board.removeDeveloper(dev.getId()); // Задача снова без разработчика
+    EXPECT_TRUE(board.hasUnassignedTasks());
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "../models/task.h"
+
+// Тесты компактного представления записей истории
+TEST(HistoryEntryTest, StandardActionsRenderOldText) {
+    Task task("Задача");
+    task.setStatus(TaskStatus::InProgress);
+    task.assignToDeveloper(7);
+    task.setTitle("Другая");
+
+    const TaskHistory& history = task.getHistory();
+    ASSERT_EQ(history.size(), 4);
+    EXPECT_EQ(history[0].getDetails(), "Задача 'Задача' создана");
+    EXPECT_EQ(history[1].getActionCode(), HistoryAction::StatusChanged);
+    EXPECT_EQ(history[1].getAction(), "Смена статуса");
+    EXPECT_EQ(history[1].getDetails(), "Backlog → InProgress");
+    EXPECT_EQ(history[2].getDetails(), "Назначен разработчик ID: 7");
+    EXPECT_EQ(history[3].getDetails(), "'Задача' → 'Другая'");
+}
+
+TEST(HistoryEntryTest, JsonTextIsRecognized) {
+    TaskHistoryEntry entry = TaskHistoryEntry::fromText(0, "Смена статуса", "Review → Done");
+    EXPECT_EQ(entry.getActionCode(), HistoryAction::StatusChanged);
+    EXPECT_EQ(entry.getDetails(), "Review → Done");
+
+    entry = TaskHistoryEntry::fromText(0, "Изменение дедлайна", "Установлен дедлайн: 05.03.2025");
+    EXPECT_EQ(entry.getActionCode(), HistoryAction::DeadlineSet);
+    EXPECT_EQ(entry.getDetails(), "Установлен дедлайн: 05.03.2025");
+
+    // Текст, который не совпадает с шаблоном, сохраняется как есть
+    entry = TaskHistoryEntry::fromText(0, "Смена статуса", "вручную");
+    EXPECT_EQ(entry.getActionCode(), HistoryAction::Custom);
+    EXPECT_EQ(entry.getDetails(), "вручную");
+    EXPECT_EQ(entry.getAction(), "Смена статуса");
+}
+
+TEST(HistoryEntryTest, JsonRoundTrip) {
+    Task task("Задача");
+    task.setDeadline(QDateTime(QDate(2025, 3, 5), QTime(18, 0)));
+    task.addHistoryEntry("Комментарий", "Любой текст");
+
+    for (const TaskHistoryEntry& entry : task.getHistory()) {
+        QJsonObject json = entry.toJson();
+        TaskHistoryEntry copy = TaskHistoryEntry::fromJson(json);
+        EXPECT_EQ(copy.getAction(), entry.getAction());
+        EXPECT_EQ(copy.getDetails(), entry.getDetails());
+        EXPECT_EQ(copy.toJson(), json);
+    }
+}
+
+TEST(HistoryEntryTest, ValuesSurviveCompactPacking) {
+    // Дедлайн до эпохи и после неё, отрицательное значение сохраняют знак
+    const QDateTime past(QDate(1960, 1, 2), QTime(0, 0));
+    const QDateTime future(QDate(2300, 12, 31), QTime(0, 0));
+    EXPECT_EQ(TaskHistoryEntry::deadlineChanged(past).getDetails(), "Установлен дедлайн: 02.01.1960");
+    EXPECT_EQ(TaskHistoryEntry::deadlineChanged(future).getDetails(), "Установлен дедлайн: 31.12.2300");
+    EXPECT_EQ(TaskHistoryEntry::assigned(-5).getDetails(), "Назначен разработчик ID: -5");
+
+    // Копия записи разделяет строки с оригиналом
+    TaskHistoryEntry custom = TaskHistoryEntry::custom("Комментарий", "Проверено");
+    TaskHistoryEntry copy = custom;
+    EXPECT_EQ(copy.getActionCode(), HistoryAction::Custom);
+    EXPECT_EQ(copy.getAction(), "Комментарий");
+    EXPECT_EQ(copy.getDetails(), "Проверено");
+    EXPECT_EQ(TaskHistoryEntry::created(QString()).getDetails(), "Задача создана");
+}
+
+TEST(HistoryEntryTest, MissingTimestampStaysEmpty) {
+    QJsonObject json;
+    json["timestamp"] = "";
+    json["action"] = "Комментарий";
+    json["details"] = "Без даты";
+
+    TaskHistoryEntry entry = TaskHistoryEntry::fromJson(json);
+    EXPECT_FALSE(entry.getTimestamp().isValid());
+    EXPECT_EQ(entry.toJson()["timestamp"].toString(), QString());
+    EXPECT_EQ(entry.toJson(), json);
+
+    // Запись с настоящей нулевой меткой (1970 год) от пустой отличается
+    TaskHistoryEntry epoch = TaskHistoryEntry::fromText(0, "Комментарий", "Без даты");
+    EXPECT_TRUE(epoch.getTimestamp().isValid());
+}
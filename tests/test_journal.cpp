@@ -0,0 +1,152 @@
+#include <gtest/gtest.h>
+#include <QFile>
+#include <QFileInfo>
+#include <QTemporaryDir>
+#include "../models/board.h"
+
+// Тесты журнала изменений доски
+class JournalTest : public ::testing::Test {
+protected:
+    QTemporaryDir dir;
+    QString path;
+    Board board;
+    int taskId = -1;
+
+    void SetUp() override {
+        path = dir.filePath("board.json");
+        Task task("Задача", "Описание");
+        taskId = task.getId();
+        board.addTask(task);
+        ASSERT_TRUE(board.saveToFile(path));
+        ASSERT_TRUE(board.openJournal(path, true));
+    }
+};
+
+TEST_F(JournalTest, ChangesAreReplayedOnRecovery) {
+    board.getTask(taskId)->setStatus(TaskStatus::InProgress);
+    board.getTask(taskId)->setTitle("Новое название");
+    Task added("Добавленная");
+    board.addTask(added);
+    ASSERT_TRUE(board.syncJournal());
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    ASSERT_EQ(loaded.getTasks().size(), 2);
+    const Task* task = loaded.getTask(taskId);
+    ASSERT_NE(task, nullptr);
+    EXPECT_EQ(task->getStatus(), TaskStatus::InProgress);
+    EXPECT_EQ(task->getTitle(), "Новое название");
+    // Записи истории не дублируются при проигрывании
+    EXPECT_EQ(task->getHistory().size(), board.getTask(taskId)->getHistory().size());
+}
+
+TEST_F(JournalTest, RemovalKeepsTaskOrder) {
+    const int second = board.createTask("Вторая")->getId();
+    const int third = board.createTask("Третья")->getId();
+    board.removeTask(taskId);
+    board.createTask("Четвёртая");
+    board.removeTask(third);
+    ASSERT_TRUE(board.syncJournal());
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    QStringList titles;
+    for (const Task& task : loaded.getTasks()) {
+        titles << task.getTitle();
+    }
+    EXPECT_EQ(titles, QStringList({"Вторая", "Четвёртая"}));
+    EXPECT_NE(loaded.getTask(second), nullptr);
+}
+
+TEST_F(JournalTest, UndoneRemovalKeepsPosition) {
+    board.createTask("Вторая");
+    ASSERT_TRUE(board.removeTask(taskId));
+    ASSERT_TRUE(board.undo()); // Задача возвращается в начало списка
+    ASSERT_TRUE(board.syncJournal());
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    ASSERT_EQ(loaded.getTasks().size(), 2);
+    EXPECT_EQ(loaded.getTasks().first().getId(), taskId);
+}
+
+TEST_F(JournalTest, DeveloperRemovalKeepsOrder) {
+    const int first = board.createDeveloper("Анна")->getId();
+    board.createDeveloper("Борис");
+    board.createDeveloper("Вера");
+    ASSERT_TRUE(board.removeDeveloper(first));
+    ASSERT_TRUE(board.syncJournal());
+
+    auto names = [](const Board& source) {
+        QStringList result;
+        for (const Developer& dev : source.getDevelopers()) {
+            result << dev.getName();
+        }
+        return result;
+    };
+    EXPECT_EQ(names(board), QStringList({"Борис", "Вера"}));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    EXPECT_EQ(names(loaded), QStringList({"Борис", "Вера"}));
+}
+
+TEST_F(JournalTest, SnapshotDoesNotReapplyJournal) {
+    board.getTask(taskId)->addHistoryEntry("Тест", "Запись");
+    ASSERT_TRUE(board.syncJournal());
+    int historySize = board.getTask(taskId)->getHistory().size();
+
+    // Снимок сохранён, но журнал не очищен (как при сбое между этими шагами)
+    ASSERT_TRUE(board.saveToFile(path));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    EXPECT_EQ(loaded.getTask(taskId)->getHistory().size(), historySize);
+}
+
+TEST_F(JournalTest, CompactClearsJournal) {
+    board.getTask(taskId)->setStatus(TaskStatus::Done);
+    ASSERT_TRUE(board.compactJournal());
+    EXPECT_EQ(QFileInfo(BoardJournal::journalFileName(path)).size(), 0);
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    EXPECT_EQ(loaded.getTask(taskId)->getStatus(), TaskStatus::Done);
+}
+
+TEST_F(JournalTest, TornRecordIsIgnored) {
+    board.getTask(taskId)->setStatus(TaskStatus::Review);
+    board.closeJournal();
+
+    QFile journal(BoardJournal::journalFileName(path));
+    ASSERT_TRUE(journal.open(QIODevice::Append));
+    journal.write("{\"seq\":999,\"op\":\"set\",\"id\""); // Оборванная запись
+    journal.close();
+
+    Board loaded;
+    ASSERT_TRUE(loaded.recoverFromFile(path, path));
+    EXPECT_EQ(loaded.getTask(taskId)->getStatus(), TaskStatus::Review);
+}
+
+TEST_F(JournalTest, PlainLoadIgnoresJournal) {
+    board.getTask(taskId)->setStatus(TaskStatus::Done);
+    ASSERT_TRUE(board.syncJournal());
+
+    // Файл пользователя открывается как есть: журнал читается только при восстановлении
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    EXPECT_EQ(loaded.getTask(taskId)->getStatus(), TaskStatus::Backlog);
+}
+
+TEST_F(JournalTest, RecoveryWithoutSnapshotStartsFromEmptyBoard) {
+    const QString recoveryPath = dir.filePath("recovery.json");
+    Board fresh;
+    ASSERT_TRUE(fresh.openJournal(recoveryPath, true));
+    fresh.createTask("Новая");
+    ASSERT_TRUE(fresh.syncJournal());
+
+    Board recovered;
+    ASSERT_TRUE(recovered.recoverFromFile(QString(), recoveryPath));
+    ASSERT_EQ(recovered.getTasks().size(), 1);
+    EXPECT_EQ(recovered.getTasks().first().getTitle(), "Новая");
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+#include <QBuffer>
+#include <QFileInfo>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QTemporaryDir>
+#include "../models/board.h"
+#include "../models/jsonstreamreader.h"
+#include "../models/jsonstreamwriter.h"
+
+// Тесты потокового чтения и записи JSON
+static QJsonObject firstTask(const QByteArray& json, QString* error = nullptr) {
+    QBuffer buffer;
+    buffer.setData(json);
+    buffer.open(QIODevice::ReadOnly);
+
+    JsonStreamReader reader(&buffer);
+    QJsonObject result;
+    QString key;
+    if (reader.enterObject()) {
+        while (reader.nextKey(key)) {
+            if (key == "tasks" && reader.enterArray()) {
+                while (reader.nextElement()) {
+                    QJsonObject obj = reader.readObject();
+                    if (result.isEmpty()) result = obj;
+                }
+            } else {
+                reader.skipValue();
+            }
+        }
+    }
+    if (error) *error = reader.errorString();
+    return result;
+}
+
+TEST(JsonStreamReaderTest, ReadsElementsAndSkipsUnknownKeys) {
+    QByteArray json = R"({"version": 2, "meta": {"a": [1, 2, {"b": "}]"}]},
+                          "tasks": [{"id": 5, "title": "Задача \"в кавычках\""}, {"id": 6}]})";
+    QString error;
+    QJsonObject task = firstTask(json, &error);
+
+    EXPECT_TRUE(error.isEmpty()) << error.toStdString();
+    EXPECT_EQ(task["id"].toInt(), 5);
+    EXPECT_EQ(task["title"].toString(), "Задача \"в кавычках\"");
+}
+
+TEST(JsonStreamReaderTest, EscapedKeys) {
+    // Ключ с экранированной кавычкой не должен сбивать разбор
+    QByteArray json = R"({"we\"ird": "x", "tasks": [{"id": 1}]})";
+    QString error;
+    EXPECT_EQ(firstTask(json, &error)["id"].toInt(), 1);
+    EXPECT_TRUE(error.isEmpty());
+}
+
+TEST(JsonStreamReaderTest, ReportsTruncatedInput) {
+    QString error;
+    firstTask(R"({"tasks": [{"id": 1}, {"id": )", &error);
+    EXPECT_FALSE(error.isEmpty());
+}
+
+TEST(JsonStreamReaderTest, BoardLoadKeepsOldDataOnError) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("broken.json");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(R"({"developers": [], "tasks": [{"id": 1, "title": "A"},)");
+    file.close();
+
+    Board board;
+    Task task("Существующая задача");
+    board.addTask(task);
+
+    EXPECT_FALSE(board.loadFromFile(path));
+    EXPECT_EQ(board.getTasks().size(), 1); // Доска не испорчена
+}
+
+TEST(JsonStreamReaderTest, BoardRoundTripWithProgress) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("board.json");
+
+    Board board;
+    Developer dev("Иван", "Разработчик");
+    board.addDeveloper(dev);
+    for (int i = 0; i < 100; i++) {
+        Task task(QString("Задача %1").arg(i), "Описание");
+        task.assignToDeveloper(dev.getId());
+        board.addTask(task);
+    }
+    ASSERT_TRUE(board.saveToFile(path));
+
+    Board loaded;
+    qint64 lastRead = 0;
+    qint64 total = 0;
+    ASSERT_TRUE(loaded.loadFromFile(path, [&](qint64 bytesRead, qint64 totalBytes) {
+        lastRead = bytesRead;
+        total = totalBytes;
+    }));
+
+    EXPECT_EQ(loaded.getTasks().size(), 100);
+    EXPECT_EQ(loaded.getDevelopers().size(), 1);
+    EXPECT_EQ(loaded.countTasksByDeveloper(dev.getId()), 100);
+    EXPECT_GT(total, 0);
+    EXPECT_EQ(lastRead, total);
+}
+
+TEST(JsonStreamReaderTest, ParallelLoadKeepsOrderAndIds) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("large.json");
+
+    // Несколько порций разбора, последняя неполная
+    Board board;
+    QList<int> ids;
+    for (int i = 0; i < 2000; i++) {
+        Task task(QString("Задача %1").arg(i));
+        task.setStatus(TaskStatus::InProgress);
+        ids.append(task.getId());
+        board.addTask(task);
+    }
+    ASSERT_TRUE(board.saveToFile(path));
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    ASSERT_EQ(loaded.getTasks().size(), ids.size());
+    for (int i = 0; i < ids.size(); i++) {
+        EXPECT_EQ(loaded.getTasks()[i].getId(), ids[i]);
+    }
+    EXPECT_EQ(loaded.getTasks().last().getHistory().size(), 2);
+
+    Task fresh("Новая");
+    EXPECT_GT(fresh.getId(), ids.last()); // Счётчик ID учёл загруженные задачи
+}
+
+TEST(JsonStreamReaderTest, BrokenTaskFailsParallelLoad) {
+    QTemporaryDir dir;
+    QString path = dir.filePath("broken_task.json");
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    file.write(R"({"developers": [], "tasks": [{"id": 1, "title": "A"}, [1, 2]]})");
+    file.close();
+
+    Board board;
+    EXPECT_FALSE(board.loadFromFile(path)); // Элемент массива задач - не объект
+}
+
+TEST(JsonStreamWriterTest, EscapesStrings) {
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    {
+        JsonStreamWriter writer(&buffer);
+        writer.beginObject();
+        writer.key("text");
+        writer.value(QString("кавычка \" слэш \\ перевод\nстроки \x01"));
+        writer.key("list");
+        writer.beginArray();
+        writer.value(1);
+        writer.value(true);
+        writer.nullValue();
+        writer.endArray();
+        writer.endObject();
+        EXPECT_TRUE(writer.flush());
+    }
+
+    QJsonParseError error;
+    QJsonDocument doc = QJsonDocument::fromJson(buffer.data(), &error);
+    ASSERT_EQ(error.error, QJsonParseError::NoError);
+    EXPECT_EQ(doc.object()["text"].toString(), QString("кавычка \" слэш \\ перевод\nстроки \x01"));
+    EXPECT_EQ(doc.object()["list"].toArray().size(), 3);
+}
+
+TEST(JsonStreamWriterTest, TaskMatchesToJson) {
+    Task task("Задача", "Описание");
+    task.setDeadline(QDateTime::currentDateTime().addDays(2));
+    task.addHistoryEntry("Тест", "Запись");
+
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    JsonStreamWriter writer(&buffer);
+    task.writeJson(writer);
+    ASSERT_TRUE(writer.flush());
+
+    EXPECT_EQ(QJsonDocument::fromJson(buffer.data()).object(), task.toJson());
+}
+
+TEST(JsonStreamWriterTest, SaveDoesNotTouchFileOnFailure) {
+    QTemporaryDir dir;
+    Board board;
+    // Каталог вместо файла - записать не получится
+    EXPECT_FALSE(board.saveToFile(dir.path()));
+    EXPECT_TRUE(QFileInfo(dir.path()).isDir());
+}
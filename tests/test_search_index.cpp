@@ -0,0 +1,142 @@
+#include <gtest/gtest.h>
+#include <QTemporaryDir>
+#include "../models/board.h"
+#include "../models/searchindex.h"
+
+// Тесты полнотекстового индекса
+TEST(SearchIndexTest, FindsSubstringIgnoringCase) {
+    SearchIndex index;
+    index.setText(1, "Исправить ОШИБКУ входа");
+    index.setText(2, "Написать документацию");
+
+    EXPECT_EQ(index.search("ошибк"), QSet<int>({1}));
+    EXPECT_EQ(index.search("ДОКУМЕНТ"), QSet<int>({2}));
+    EXPECT_TRUE(index.search("нет такого").isEmpty());
+}
+
+TEST(SearchIndexTest, ShortQueriesAndEmptyQuery) {
+    SearchIndex index;
+    index.setText(1, "ab");
+    index.setText(2, "xyz");
+
+    EXPECT_EQ(index.search("B"), QSet<int>({1}));
+    EXPECT_EQ(index.search("").size(), 2);
+}
+
+TEST(SearchIndexTest, TrigramsAloneAreNotEnough) {
+    SearchIndex index;
+    index.setText(1, "abcd bcde"); // Все триграммы "abcde" есть, но подстроки нет
+    EXPECT_TRUE(index.search("abcde").isEmpty());
+}
+
+TEST(SearchIndexTest, SetTextReplacesAndRemoveForgets) {
+    SearchIndex index;
+    index.setText(1, "старый текст");
+    index.setText(1, "новый текст");
+
+    EXPECT_TRUE(index.search("старый").isEmpty());
+    EXPECT_EQ(index.search("новый"), QSet<int>({1}));
+
+    index.remove(1);
+    EXPECT_TRUE(index.search("текст").isEmpty());
+    EXPECT_EQ(index.size(), 0);
+}
+
+TEST(SearchIndexTest, HistoryKeepsOnlyTrigrams) {
+    SearchIndex index;
+    index.setText(1, "заголовок");
+    index.addHistory(1, "Назначен разработчик");
+
+    // Текст истории не хранится: задача - лишь кандидат, которого проверяет владелец индекса
+    QSet<int> candidates;
+    EXPECT_TRUE(index.search("разработчик", {}, &candidates).isEmpty());
+    EXPECT_EQ(candidates, QSet<int>({1}));
+    EXPECT_TRUE(index.mayMatchHistory(1, "РАЗРАБ"));
+    EXPECT_FALSE(index.matches(1, "разраб"));
+    EXPECT_EQ(index.search("заголовок", {}, &candidates), QSet<int>({1}));
+    EXPECT_TRUE(candidates.isEmpty());
+
+    index.removeHistory(1, "Назначен разработчик");
+    index.search("разработчик", {}, &candidates);
+    EXPECT_TRUE(candidates.isEmpty());
+    EXPECT_FALSE(index.mayMatchHistory(1, "разраб"));
+}
+
+// Индекс внутри доски следит за изменениями задач
+TEST(SearchIndexTest, BoardSearchCoversTitleDescriptionAndHistory) {
+    Board board;
+    Task task("Починить сборку", "Падает линковка тестов");
+    board.addTask(task);
+    Task* stored = board.getTask(task.getId());
+
+    EXPECT_TRUE(board.searchTasks("СБОРКУ").contains(task.getId()));
+    EXPECT_TRUE(board.searchTasks("линковка").contains(task.getId()));
+
+    stored->setTitle("Обновить зависимости");
+    EXPECT_TRUE(board.searchTasks("зависимост").contains(task.getId()));
+    // Старое название осталось только в истории ("'Починить сборку' → ...")
+    EXPECT_TRUE(board.searchTasks("починить").contains(task.getId()));
+
+    stored->assignToDeveloper(7);
+    EXPECT_TRUE(board.searchTasks("ID: 7").contains(task.getId()));
+
+    board.removeTask(task.getId());
+    EXPECT_TRUE(board.searchTasks("зависимост").isEmpty());
+}
+
+// История из *.sbb читается не при загрузке, а при indexHistory()
+TEST(SearchIndexTest, BinaryHistoryIsIndexedOnDemand) {
+    QTemporaryDir dir;
+    const QString path = dir.filePath("board.sbb");
+    {
+        Board board;
+        Task* task = board.createTask("Старое название");
+        task->setTitle("Новое название");
+        ASSERT_TRUE(board.saveToFile(path));
+    }
+
+    Board loaded;
+    ASSERT_TRUE(loaded.loadFromFile(path));
+    const int taskId = loaded.getTasks().first().getId();
+    EXPECT_TRUE(loaded.searchTasks("новое").contains(taskId));
+    EXPECT_TRUE(loaded.searchTasks("старое").isEmpty());
+
+    EXPECT_EQ(loaded.indexHistory(), 1);
+    EXPECT_TRUE(loaded.searchTasks("старое").contains(taskId));
+    EXPECT_TRUE(loaded.taskMatchesSearch(taskId, "СТАРОЕ"));
+    EXPECT_TRUE(loaded.getTasks().first().getHistory().isLazy()); // Индекс не держит историю в памяти
+    EXPECT_EQ(loaded.indexHistory(), 0);
+
+    loaded.removeTask(taskId);
+    EXPECT_TRUE(loaded.searchTasks("старое").isEmpty());
+}
+
+TEST(SearchIndexTest, SnapshotIsIndependentOfLaterChanges) {
+    SearchIndex index;
+    index.setText(1, "первая задача");
+    SearchIndex snapshot = index; // Снимок для фонового поиска
+
+    index.setText(2, "вторая задача");
+    index.remove(1);
+
+    EXPECT_EQ(snapshot.search("задача"), QSet<int>({1}));
+    EXPECT_EQ(index.search("задача"), QSet<int>({2}));
+}
+
+TEST(SearchIndexTest, CancelledSearchReturnsEmpty) {
+    SearchIndex index;
+    for (int i = 0; i < 5000; i++) {
+        index.setText(i, QString("задача %1").arg(i));
+    }
+
+    EXPECT_TRUE(index.search("задача", []() { return true; }).isEmpty());
+    EXPECT_EQ(index.search("задача", []() { return false; }).size(), 5000);
+}
+
+TEST(SearchIndexTest, MatchesSingleTask) {
+    SearchIndex index;
+    index.setText(1, "Релиз");
+    EXPECT_TRUE(index.matches(1, "РЕЛ"));
+    EXPECT_FALSE(index.matches(1, "сборка"));
+    EXPECT_FALSE(index.matches(2, "Релиз"));
+}
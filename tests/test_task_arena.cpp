@@ -0,0 +1,52 @@
+#include <gtest/gtest.h>
+#include "../models/taskarena.h"
+#include "../models/board.h"
+
+// Тесты арены задач: постоянные адреса и повторное использование ячеек
+TEST(TaskArenaTest, FreedSlotIsReused) {
+    TaskArena arena;
+    Task* first = arena.create(Task("Первая"));
+    Task* second = arena.create(Task("Вторая"));
+    EXPECT_EQ(arena.size(), 2);
+
+    arena.destroy(first);
+    Task* third = arena.create(Task("Третья"));
+    EXPECT_EQ(third, first); // Заняла освободившуюся ячейку
+    EXPECT_EQ(third->getTitle(), "Третья");
+    EXPECT_EQ(second->getTitle(), "Вторая");
+
+    arena.destroy(second);
+    arena.destroy(third);
+    EXPECT_EQ(arena.size(), 0);
+}
+
+TEST(TaskArenaTest, ReserveAllocatesOneBlock) {
+    TaskArena arena;
+    arena.reserve(10000);
+    EXPECT_EQ(arena.blockCount(), 1);
+    EXPECT_GE(arena.capacity(), 10000);
+
+    QVector<Task*> created;
+    for (int i = 0; i < 10000; i++) {
+        created.append(arena.create(Task()));
+    }
+    EXPECT_EQ(arena.blockCount(), 1);
+
+    for (Task* task : created) {
+        arena.destroy(task);
+    }
+}
+
+TEST(TaskArenaTest, BoardPointersSurviveGrowth) {
+    Board board;
+    Task task("Первая");
+    board.addTask(task);
+    Task* pointer = board.getTask(task.getId());
+
+    for (int i = 0; i < 5000; i++) {
+        board.addTask(Task(QString("Задача %1").arg(i)));
+    }
+    EXPECT_EQ(board.getTask(task.getId()), pointer);
+    EXPECT_EQ(pointer->getTitle(), "Первая");
+    EXPECT_FALSE(board.takeChanges().changed.isEmpty());
+}
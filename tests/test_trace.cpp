@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+#include "../models/trace.h"
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+// Тесты трассировки (классы доступны и без SCRUM_BOARD_TRACING - выключаются только макросы)
+class TraceTest : public ::testing::Test {
+protected:
+    void SetUp() override {
+        Trace::clear();
+        Trace::setEnabled(true);
+    }
+
+    void TearDown() override {
+        Trace::setEnabled(false);
+        Trace::clear();
+    }
+};
+
+TEST_F(TraceTest, ScopeRecordsEventOnlyWhenEnabled) {
+    {
+        TraceScope scope("включено");
+    }
+    EXPECT_EQ(Trace::eventCount(), 1);
+
+    Trace::setEnabled(false);
+    {
+        TraceScope scope("выключено");
+    }
+    EXPECT_EQ(Trace::eventCount(), 1);
+}
+
+TEST_F(TraceTest, FinishRecordsOnce) {
+    TraceScope scope("диалог");
+    scope.finish();
+    scope.finish();
+    EXPECT_EQ(Trace::eventCount(), 1);
+}
+
+TEST_F(TraceTest, WritesChromeTraceEvents) {
+    {
+        TraceScope outer("внешний", "test");
+        TraceScope inner("внутренний", "test");
+    }
+
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    QString path = dir.filePath("trace.json");
+    ASSERT_TRUE(Trace::writeChromeTrace(path));
+
+    QFile file(path);
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+    QJsonArray events = QJsonDocument::fromJson(file.readAll()).object()["traceEvents"].toArray();
+    ASSERT_EQ(events.size(), 2);
+
+    // Внутренний блок закрывается первым и лежит внутри внешнего по времени
+    QJsonObject inner = events[0].toObject();
+    QJsonObject outer = events[1].toObject();
+    EXPECT_EQ(inner["name"].toString(), QString("внутренний"));
+    EXPECT_EQ(outer["name"].toString(), QString("внешний"));
+    EXPECT_EQ(inner["ph"].toString(), QString("X"));
+    EXPECT_EQ(inner["cat"].toString(), QString("test"));
+    EXPECT_GE(inner["ts"].toDouble(), outer["ts"].toDouble());
+    EXPECT_LE(inner["ts"].toDouble() + inner["dur"].toDouble(),
+              outer["ts"].toDouble() + outer["dur"].toDouble());
+    EXPECT_EQ(inner["tid"].toDouble(), outer["tid"].toDouble());
+}
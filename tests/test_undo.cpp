@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include "../models/board.h"
+
+// Тесты отмены и повтора изменений доски
+class UndoTest : public ::testing::Test {
+protected:
+    Board board;
+};
+
+TEST_F(UndoTest, UndoAndRedoTaskRemoval) {
+    int id = board.createTask("Задача", "Описание")->getId();
+    board.getTask(id)->setStatus(TaskStatus::InProgress);
+
+    board.removeTask(id);
+    EXPECT_EQ(board.getUndoStack().undoText(), QString("Удаление задачи «Задача»"));
+
+    ASSERT_TRUE(board.undo());
+    ASSERT_TRUE(board.hasTask(id));
+    EXPECT_EQ(board.getTask(id)->getDescription(), QString("Описание"));
+    EXPECT_EQ(board.getTask(id)->getStatus(), TaskStatus::InProgress);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::InProgress), 1);
+
+    ASSERT_TRUE(board.redo());
+    EXPECT_FALSE(board.hasTask(id));
+    EXPECT_EQ(board.getStats().total, 0);
+}
+
+TEST_F(UndoTest, SetterChangesAreRecorded) {
+    Task* task = board.createTask("Задача");
+    int id = task->getId();
+    task->setStatus(TaskStatus::Review);
+    task->setDescription("Новое описание");
+
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.getTask(id)->getDescription(), QString());
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.getTask(id)->getStatus(), TaskStatus::Backlog);
+    ASSERT_TRUE(board.undo());
+    EXPECT_FALSE(board.hasTask(id));
+    EXPECT_FALSE(board.undo());
+}
+
+TEST_F(UndoTest, StepGroupsChanges) {
+    Task* task = board.createTask("Старое название");
+    int id = task->getId();
+    int before = board.getUndoStack().undoCount();
+
+    board.beginUndoStep("Редактирование");
+    task->setTitle("Новое название");
+    task->setDeadline(QDateTime::currentDateTime().addDays(2));
+    board.endUndoStep();
+    EXPECT_EQ(board.getUndoStack().undoCount(), before + 1);
+    EXPECT_EQ(board.getUndoStack().undoText(), QString("Редактирование"));
+
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.getTask(id)->getTitle(), QString("Старое название"));
+    EXPECT_FALSE(board.getTask(id)->hasDeadline());
+}
+
+TEST_F(UndoTest, UndoDeveloperRemovalRestoresAssignments) {
+    int devId = board.createDeveloper("Иван")->getId();
+    int id1 = board.createTask("Задача 1")->getId();
+    int id2 = board.createTask("Задача 2")->getId();
+    board.getTask(id1)->assignToDeveloper(devId);
+    board.getTask(id2)->assignToDeveloper(devId);
+
+    ASSERT_TRUE(board.removeDeveloper(devId));
+    EXPECT_EQ(board.countTasksByDeveloper(-1), 2);
+
+    ASSERT_TRUE(board.undo()); // Разработчик и оба назначения - один шаг
+    ASSERT_NE(board.getDeveloper(devId), nullptr);
+    EXPECT_EQ(board.getTask(id1)->getAssignedDeveloperId(), devId);
+    EXPECT_EQ(board.getTask(id2)->getAssignedDeveloperId(), devId);
+    EXPECT_EQ(board.countTasksByDeveloper(devId), 2);
+
+    ASSERT_TRUE(board.redo());
+    EXPECT_EQ(board.getDeveloper(devId), nullptr);
+    EXPECT_EQ(board.countTasksByDeveloper(-1), 2);
+}
+
+TEST_F(UndoTest, UndoRemovalRestoresPosition) {
+    auto titles = [this]() {
+        QStringList result;
+        for (const Task& task : board.getTasks()) {
+            result << task.getTitle();
+        }
+        return result;
+    };
+    const int first = board.createTask("A")->getId();
+    const int second = board.createTask("B")->getId();
+    board.createTask("C");
+    const int fourth = board.createTask("D")->getId();
+
+    ASSERT_TRUE(board.removeTask(first));
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(titles(), QStringList({"A", "B", "C", "D"}));
+
+    ASSERT_TRUE(board.applyBatch({BoardOperation::removeTask(second), BoardOperation::removeTask(fourth)}));
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(titles(), QStringList({"A", "B", "C", "D"}));
+
+    const int devId = board.createDeveloper("Иван")->getId();
+    board.createDeveloper("Пётр");
+    ASSERT_TRUE(board.removeDeveloper(devId));
+    ASSERT_TRUE(board.undo());
+    ASSERT_EQ(board.getDevelopers().size(), 2);
+    EXPECT_EQ(board.getDevelopers().first().getName(), QString("Иван"));
+}
+
+TEST_F(UndoTest, BatchIsOneStep) {
+    QList<int> ids;
+    for (int i = 0; i < 3; i++) {
+        ids.append(board.createTask(QString("Задача %1").arg(i))->getId());
+    }
+    int before = board.getUndoStack().undoCount();
+
+    QVector<BoardOperation> operations;
+    for (int id : ids) {
+        operations.append(BoardOperation::setStatus(id, TaskStatus::Done));
+    }
+    operations.append(BoardOperation::removeTask(ids[0]));
+    ASSERT_TRUE(board.applyBatch(operations));
+    EXPECT_EQ(board.getUndoStack().undoCount(), before + 1);
+
+    ASSERT_TRUE(board.undo());
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Backlog), 3);
+    EXPECT_EQ(board.countTasksByStatus(TaskStatus::Done), 0);
+}
+
+TEST_F(UndoTest, NewChangeClearsRedo) {
+    Task* task = board.createTask("Задача");
+    task->setStatus(TaskStatus::Assigned);
+    ASSERT_TRUE(board.undo());
+    EXPECT_TRUE(board.getUndoStack().canRedo());
+
+    board.getTask(task->getId())->setStatus(TaskStatus::Review);
+    EXPECT_FALSE(board.getUndoStack().canRedo());
+    EXPECT_FALSE(board.redo());
+}
+
+TEST_F(UndoTest, LimitsDropOldestSteps) {
+    board.setUndoLimits(3, 1000);
+    Task* task = board.createTask("Задача");
+    for (int i = 0; i < 5; i++) {
+        task->setDescription(QString("Версия %1").arg(i));
+    }
+    EXPECT_EQ(board.getUndoStack().undoCount(), 3);
+
+    board.setUndoLimits(100, 2); // Не больше двух операций
+    EXPECT_EQ(board.getUndoStack().undoCount(), 2);
+    EXPECT_EQ(board.getUndoStack().operationCount(), 2);
+}
+
+TEST_F(UndoTest, ClearEmptiesStack) {
+    board.createTask("Задача");
+    board.clear();
+    EXPECT_FALSE(board.getUndoStack().canUndo());
+    EXPECT_FALSE(board.undo());
+}
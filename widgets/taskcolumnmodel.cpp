@@ -0,0 +1,156 @@
+#include "taskcolumnmodel.h"
+#include <QMimeData>
+#include <QMetaObject>
+#include <algorithm>
+
+const char* TaskColumnModel::taskIdMimeType = "application/x-scrumboard-task-id";
+
+TaskColumnModel::TaskColumnModel(Board* board, TaskStatus status, QObject* parent)
+    : QAbstractListModel(parent),
+    board(board),
+    status(status) {
+}
+
+void TaskColumnModel::setFilter(const std::function<bool(const Task&)>& newFilter) {
+    filter = newFilter;
+}
+
+bool TaskColumnModel::accepts(const Task* task) const {
+    return task && task->getStatus() == status && (!filter || filter(*task));
+}
+
+void TaskColumnModel::reload() {
+    beginResetModel();
+    taskIds.clear();
+    const QList<Task*> columnTasks = board->getTasksByStatus(status); // O(размер колонки)
+    taskIds.reserve(columnTasks.size());
+    for (Task* task : columnTasks) {
+        if (accepts(task)) {
+            taskIds.append(task->getId());
+        }
+    }
+    std::sort(taskIds.begin(), taskIds.end());
+    endResetModel();
+}
+
+void TaskColumnModel::applyChanges(const BoardChanges& changes) {
+    if (changes.reset) {
+        reload();
+        return;
+    }
+
+    for (int taskId : changes.removed) {
+        removeTask(taskId);
+    }
+    for (int taskId : changes.changed) {
+        bool shouldContain = accepts(board->getTask(taskId));
+        int row = rowOf(taskId);
+        if (shouldContain && row < 0) {
+            insertTask(taskId); // Задача пришла в колонку
+        } else if (!shouldContain && row >= 0) {
+            removeTask(taskId); // Задача ушла из колонки
+        } else if (row >= 0) {
+            QModelIndex changed = index(row);
+            emit dataChanged(changed, changed); // Изменились поля задачи
+        }
+    }
+}
+
+int TaskColumnModel::rowOf(int taskId) const {
+    auto it = std::lower_bound(taskIds.constBegin(), taskIds.constEnd(), taskId);
+    if (it == taskIds.constEnd() || *it != taskId) {
+        return -1;
+    }
+    return int(it - taskIds.constBegin());
+}
+
+void TaskColumnModel::insertTask(int taskId) {
+    int row = int(std::lower_bound(taskIds.begin(), taskIds.end(), taskId) - taskIds.begin());
+    beginInsertRows(QModelIndex(), row, row);
+    taskIds.insert(row, taskId);
+    endInsertRows();
+}
+
+void TaskColumnModel::removeTask(int taskId) {
+    int row = rowOf(taskId);
+    if (row < 0) {
+        return;
+    }
+    beginRemoveRows(QModelIndex(), row, row);
+    taskIds.remove(row);
+    endRemoveRows();
+}
+
+int TaskColumnModel::rowCount(const QModelIndex& parent) const {
+    return parent.isValid() ? 0 : taskIds.size(); // Плоский список без вложенности
+}
+
+QVariant TaskColumnModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= taskIds.size()) {
+        return QVariant();
+    }
+
+    const Task* task = board->getTask(taskIds[index.row()]);
+    if (!task) {
+        return QVariant();
+    }
+
+    switch (role) {
+    case Qt::DisplayRole:
+        return task->getTitle();
+    case Qt::ToolTipRole:
+        return task->getDescription();
+    case TaskIdRole:
+        return task->getId();
+    case AssigneeRole: {
+        const Developer* dev = board->getDeveloper(task->getAssignedDeveloperId());
+        return dev ? dev->getName() : QString();
+    }
+    case DeadlineRole:
+        return task->getDeadline();
+    case OverdueRole:
+        // Корзина из доски: часы не читаются на каждую строку, а смена срочности
+        // приходит в applyChanges() вместе с остальными изменениями
+        return board->getDeadlineBucket(*task) == DeadlineBucket::Overdue;
+    default:
+        return QVariant();
+    }
+}
+
+Qt::ItemFlags TaskColumnModel::flags(const QModelIndex& index) const {
+    if (!index.isValid()) {
+        return Qt::ItemIsDropEnabled; // Бросать можно и на пустое место колонки
+    }
+    return Qt::ItemIsEnabled | Qt::ItemIsSelectable | Qt::ItemIsDragEnabled | Qt::ItemIsDropEnabled;
+}
+
+QStringList TaskColumnModel::mimeTypes() const {
+    return QStringList() << taskIdMimeType;
+}
+
+QMimeData* TaskColumnModel::mimeData(const QModelIndexList& indexes) const {
+    if (indexes.isEmpty()) {
+        return nullptr;
+    }
+    QMimeData* mime = new QMimeData();
+    mime->setData(taskIdMimeType, QByteArray::number(taskIdAt(indexes.first().row())));
+    return mime;
+}
+
+bool TaskColumnModel::canDropMimeData(const QMimeData* data, Qt::DropAction /*action*/,
+                                      int /*row*/, int /*column*/, const QModelIndex& /*parent*/) const {
+    return data && data->hasFormat(taskIdMimeType);
+}
+
+bool TaskColumnModel::dropMimeData(const QMimeData* data, Qt::DropAction action,
+                                   int row, int column, const QModelIndex& parent) {
+    if (!canDropMimeData(data, action, row, column, parent)) {
+        return false;
+    }
+    int taskId = data->data(taskIdMimeType).toInt();
+    // Сигнал откладываем: обработчик меняет модели, а представление ещё внутри dropEvent
+    QMetaObject::invokeMethod(this, [this, taskId]() {
+        emit taskDropped(taskId, status);
+    }, Qt::QueuedConnection);
+    return true;
+}
@@ -0,0 +1,66 @@
+#ifndef TASKCOLUMNMODEL_H
+#define TASKCOLUMNMODEL_H
+
+#include <QAbstractListModel> // Базовый класс списочной модели Qt
+#include <QVector>
+#include <functional>
+#include "../models/board.h"
+
+// Модель одной колонки доски для виртуализированного отображения.
+// Хранит только отсортированные ID задач; данные задачи читаются из Board
+// в момент отрисовки, поэтому виджеты создаются лишь для видимых строк.
+class TaskColumnModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    // Роли данных для делегата (Qt::DisplayRole - название задачи)
+    enum Roles {
+        TaskIdRole = Qt::UserRole + 1,
+        AssigneeRole,  // Имя назначенного разработчика
+        DeadlineRole,  // QDateTime дедлайна
+        OverdueRole    // Просрочена ли задача
+    };
+
+    TaskColumnModel(Board* board, TaskStatus status, QObject* parent = nullptr);
+
+    // Фильтр задач (например, поисковый запрос). Пустой фильтр пропускает все задачи
+    void setFilter(const std::function<bool(const Task&)>& newFilter);
+
+    void reload(); // Полная перестройка списка из индекса статусов доски
+    void applyChanges(const BoardChanges& changes); // Точечное обновление строк
+
+    TaskStatus getStatus() const { return status; }
+    int taskIdAt(int row) const { return taskIds.value(row, -1); }
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    // Перетаскивание задач между колонками
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+    QStringList mimeTypes() const override;
+    QMimeData* mimeData(const QModelIndexList& indexes) const override;
+    bool canDropMimeData(const QMimeData* data, Qt::DropAction action,
+                         int row, int column, const QModelIndex& parent) const override;
+    bool dropMimeData(const QMimeData* data, Qt::DropAction action,
+                      int row, int column, const QModelIndex& parent) override;
+    Qt::DropActions supportedDragActions() const override { return Qt::CopyAction; }
+    Qt::DropActions supportedDropActions() const override { return Qt::CopyAction; }
+
+    static const char* taskIdMimeType; // MIME-тип с ID перетаскиваемой задачи
+
+signals:
+    void taskDropped(int taskId, TaskStatus newStatus);
+
+private:
+    Board* board;
+    TaskStatus status;
+    std::function<bool(const Task&)> filter;
+    QVector<int> taskIds; // Отсортированы по возрастанию (порядок создания задач)
+
+    bool accepts(const Task* task) const; // Должна ли задача быть в этой колонке
+    int rowOf(int taskId) const;          // Бинарный поиск строки (-1 если нет)
+    void insertTask(int taskId);
+    void removeTask(int taskId);
+};
+
+#endif // TASKCOLUMNMODEL_H
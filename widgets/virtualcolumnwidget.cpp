@@ -0,0 +1,136 @@
+#include "virtualcolumnwidget.h"
+#include <QVBoxLayout>
+#include <QStyledItemDelegate> // Базовый класс для отрисовки элементов представления
+#include <QPainter>
+#include <QMenu>
+
+namespace {
+
+const int cardHeight = 64;  // Фиксированная высота карточки - позволяет uniformItemSizes
+const int cardMargin = 4;
+
+// Рисует компактную карточку задачи прямо на viewport списка
+class TaskCardDelegate : public QStyledItemDelegate {
+public:
+    using QStyledItemDelegate::QStyledItemDelegate;
+
+    void paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const override {
+        painter->save();
+        painter->setRenderHint(QPainter::Antialiasing);
+
+        QRect card = option.rect.adjusted(cardMargin, cardMargin / 2, -cardMargin, -cardMargin / 2);
+        bool overdue = index.data(TaskColumnModel::OverdueRole).toBool();
+        bool selected = option.state & QStyle::State_Selected;
+
+        painter->setPen(QPen(selected ? QColor("#1976D2") : QColor("#BDBDBD"), 1));
+        painter->setBrush(overdue ? QColor("#FFCDD2") : QColor(Qt::white));
+        painter->drawRoundedRect(card, 6, 6);
+
+        QRect text = card.adjusted(8, 4, -8, -4);
+        QFont titleFont = option.font;
+        titleFont.setBold(true);
+        painter->setFont(titleFont);
+        painter->setPen(Qt::black);
+        QString title = painter->fontMetrics().elidedText(index.data(Qt::DisplayRole).toString(),
+                                                          Qt::ElideRight, text.width());
+        painter->drawText(text, Qt::AlignLeft | Qt::AlignTop, title);
+
+        painter->setFont(option.font);
+        QString assignee = index.data(TaskColumnModel::AssigneeRole).toString();
+        QString info = assignee.isEmpty() ? "👤 Не назначена" : QString("👤 %1").arg(assignee);
+        QDateTime deadline = index.data(TaskColumnModel::DeadlineRole).toDateTime();
+        if (deadline.isValid()) {
+            info += QString("   ⏰ %1").arg(deadline.toString("dd.MM.yyyy"));
+        }
+        painter->setPen(overdue ? QColor("#C62828") : QColor("#616161"));
+        info = painter->fontMetrics().elidedText(info, Qt::ElideRight, text.width());
+        painter->drawText(text, Qt::AlignLeft | Qt::AlignBottom, info);
+
+        painter->restore();
+    }
+
+    QSize sizeHint(const QStyleOptionViewItem& option, const QModelIndex& /*index*/) const override {
+        return QSize(option.rect.width(), cardHeight);
+    }
+};
+
+} // namespace
+
+VirtualColumnWidget::VirtualColumnWidget(const QString& title, const QString& color, TaskStatus status,
+                                         Board* board, QWidget* parent)
+    : QWidget(parent),
+    board(board),
+    title(title) {
+    QVBoxLayout* layout = new QVBoxLayout(this);
+    layout->setContentsMargins(0, 0, 0, 0);
+    layout->setSpacing(5);
+
+    headerLabel = new QLabel(this);
+    headerLabel->setAlignment(Qt::AlignCenter);
+    headerLabel->setStyleSheet(QString(
+        "background-color: %1; font-weight: bold; font-size: 14px; padding: 8px; border-radius: 6px;").arg(color));
+    layout->addWidget(headerLabel);
+
+    columnModel = new TaskColumnModel(board, status, this);
+    connect(columnModel, &TaskColumnModel::taskDropped, this, &VirtualColumnWidget::taskDropped);
+    // Счётчик в заголовке следует за числом строк
+    connect(columnModel, &QAbstractItemModel::rowsInserted, this, &VirtualColumnWidget::updateHeader);
+    connect(columnModel, &QAbstractItemModel::rowsRemoved, this, &VirtualColumnWidget::updateHeader);
+    connect(columnModel, &QAbstractItemModel::modelReset, this, &VirtualColumnWidget::updateHeader);
+
+    listView = new QListView(this);
+    listView->setModel(columnModel);
+    listView->setItemDelegate(new TaskCardDelegate(listView));
+    listView->setUniformItemSizes(true);                     // Высота строки известна без опроса делегата
+    listView->setLayoutMode(QListView::Batched);             // Раскладка порциями, без блокировки интерфейса
+    listView->setVerticalScrollMode(QAbstractItemView::ScrollPerPixel);
+    listView->setSelectionMode(QAbstractItemView::SingleSelection);
+    listView->setDragDropMode(QAbstractItemView::DragDrop);
+    listView->setDefaultDropAction(Qt::CopyAction);
+    listView->setDropIndicatorShown(false);
+    listView->setContextMenuPolicy(Qt::CustomContextMenu);
+    listView->setStyleSheet("QListView { background: transparent; border: none; }");
+    layout->addWidget(listView);
+
+    connect(listView, &QListView::doubleClicked, this, [this](const QModelIndex& index) {
+        if (Task* task = taskAt(index)) {
+            emit editClicked(task);
+        }
+    });
+    connect(listView, &QListView::customContextMenuRequested, this, &VirtualColumnWidget::showContextMenu);
+
+    updateHeader();
+}
+
+void VirtualColumnWidget::updateHeader() {
+    headerLabel->setText(QString("%1 (%2)").arg(title).arg(columnModel->rowCount()));
+}
+
+Task* VirtualColumnWidget::taskAt(const QModelIndex& index) const {
+    return index.isValid() ? board->getTask(columnModel->taskIdAt(index.row())) : nullptr;
+}
+
+void VirtualColumnWidget::showContextMenu(const QPoint& pos) {
+    Task* task = taskAt(listView->indexAt(pos));
+    if (!task) {
+        return;
+    }
+
+    // Действия те же, что у кнопок на карточке TaskCard
+    QMenu menu(this);
+    QAction* editAction = menu.addAction("✏️ Редактировать");
+    QAction* statusAction = nullptr;
+    if (task->getStatus() != TaskStatus::Done) {
+        statusAction = menu.addAction("→ Следующий статус");
+    }
+    QAction* deleteAction = menu.addAction("🗑️ Удалить");
+
+    QAction* chosen = menu.exec(listView->viewport()->mapToGlobal(pos));
+    if (chosen == editAction) {
+        emit editClicked(task);
+    } else if (chosen && chosen == statusAction) {
+        emit statusChangeClicked(task);
+    } else if (chosen == deleteAction) {
+        emit deleteClicked(task);
+    }
+}
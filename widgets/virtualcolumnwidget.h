@@ -0,0 +1,39 @@
+#ifndef VIRTUALCOLUMNWIDGET_H
+#define VIRTUALCOLUMNWIDGET_H
+
+#include <QWidget>
+#include <QLabel>
+#include <QListView> // Представление отрисовывает только видимые строки модели
+#include "taskcolumnmodel.h"
+
+// Колонка доски для больших досок. В отличие от ColumnWidget не создаёт
+// по виджету TaskCard на задачу: карточки рисует делегат, и только для строк,
+// попавших в видимую область. Сигналы совпадают с сигналами TaskCard/ColumnWidget.
+class VirtualColumnWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    VirtualColumnWidget(const QString& title, const QString& color, TaskStatus status,
+                        Board* board, QWidget* parent = nullptr);
+
+    TaskColumnModel* model() const { return columnModel; }
+    void updateHeader(); // Обновить счётчик задач в заголовке
+
+signals:
+    void taskDropped(int taskId, TaskStatus newStatus);
+    void editClicked(Task* task);
+    void deleteClicked(Task* task);
+    void statusChangeClicked(Task* task);
+
+private:
+    Board* board;
+    QString title;
+    QLabel* headerLabel;
+    QListView* listView;
+    TaskColumnModel* columnModel;
+
+    Task* taskAt(const QModelIndex& index) const;
+    void showContextMenu(const QPoint& pos);
+};
+
+#endif // VIRTUALCOLUMNWIDGET_H